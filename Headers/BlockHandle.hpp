@@ -0,0 +1,79 @@
+#pragma once
+
+#include "Enums/BlockTypeEnum.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+
+class Chunk;
+
+/**
+ * Lightweight reference to a block inside a chunk.
+ * Blocks are stored as plain block type values inside the chunk,
+ * so the handle only carries the chunk and the position within it.
+ */
+struct BlockHandle
+{
+	/**
+	 * Chunk the block belongs to. nullptr if the handle does not refer to any block.
+	 */
+	Chunk* chunk;
+
+	/**
+	 * X-coordinate of the block within the chunk
+	 */
+	uint8_t x;
+
+	/**
+	 * Y-coordinate of the block within the chunk
+	 */
+	uint8_t y;
+
+	/**
+	 * Z-coordinate of the block within the chunk
+	 */
+	uint8_t z;
+
+	/**
+	 * @brief Constructor. Creates a handle that does not refer to any block.
+	 */
+	BlockHandle();
+
+	/**
+	 * @brief Constructor
+	 * @param[in] newChunk Chunk the block belongs to
+	 * @param[in] positionInChunk Position of the block within the chunk
+	 */
+	BlockHandle(Chunk* newChunk, const glm::ivec3& positionInChunk);
+
+	/**
+	 * @brief Checks whether this handle refers to a block in a loaded chunk
+	 * @return True if this handle refers to a block, false otherwise
+	 */
+	bool IsValid() const;
+
+	/**
+	 * @brief Gets the type of the referenced block
+	 * @return Block type. Returns BlockTypeEnum::AIR if the handle is not valid.
+	 */
+	BlockTypeEnum GetBlockType() const;
+
+	/**
+	 * @brief Sets the type of the referenced block
+	 * @param[in] type New block type
+	 */
+	void SetBlockType(const BlockTypeEnum& type);
+
+	/**
+	 * @brief Gets the position of the referenced block within the chunk
+	 * @return Position of the block within the chunk
+	 */
+	glm::ivec3 GetPositionInChunk() const;
+
+	/**
+	 * @brief Gets the position of the referenced block in the world
+	 * @return Position of the block in the world
+	 */
+	glm::ivec3 GetPositionInWorld() const;
+};
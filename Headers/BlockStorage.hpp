@@ -0,0 +1,179 @@
+#pragma once
+
+#include "Enums/BlockTypeEnum.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Palette-compressed block storage.
+ * Stores a palette of the block types in use, and a bit-packed
+ * index into the palette for each entry.
+ */
+class BlockStorage
+{
+private:
+	/**
+	 * Block types referenced by the packed indices
+	 */
+	std::vector<BlockTypeEnum> m_palette;
+
+	/**
+	 * Bit-packed palette indices
+	 */
+	std::vector<uint64_t> m_data;
+
+	/**
+	 * Number of bits used by each packed index. Always a power of two so that
+	 * an index never straddles two words. A value of 0 means that every entry
+	 * refers to the first palette entry.
+	 */
+	uint32_t m_bitsPerEntry;
+
+	/**
+	 * Number of entries in the storage
+	 */
+	uint32_t m_size;
+
+public:
+	/**
+	 * @brief Constructor
+	 * @param[in] size Number of entries in the storage
+	 */
+	BlockStorage(const uint32_t& size);
+
+	/**
+	 * @brief Destructor
+	 */
+	~BlockStorage();
+
+	/**
+	 * @brief Gets the block type at the specified index
+	 * @param[in] index Entry index
+	 * @return Block type at the specified index
+	 */
+	BlockTypeEnum Get(const uint32_t& index) const;
+
+	/**
+	 * @brief Sets the block type at the specified index
+	 * @param[in] index Entry index
+	 * @param[in] type New block type
+	 */
+	void Set(const uint32_t& index, const BlockTypeEnum& type);
+
+	/**
+	 * @brief Resets every entry to air
+	 */
+	void Clear();
+
+	/**
+	 * @brief Removes unused block types from the palette and repacks the data
+	 * with the smallest number of bits per entry. If only one block type remains,
+	 * the packed data is released and the storage holds that single value.
+	 */
+	void Compact();
+
+	/**
+	 * @brief Checks whether every entry has the same block type
+	 * @return True if every entry has the same block type, false otherwise
+	 */
+	bool IsUniform() const;
+
+	/**
+	 * @brief Gets the number of entries in the storage
+	 * @return Number of entries
+	 */
+	uint32_t GetSize() const;
+
+	/**
+	 * @brief Gets the number of bits used by each packed index
+	 * @return Number of bits per entry
+	 */
+	uint32_t GetBitsPerEntry() const;
+
+	/**
+	 * @brief Gets the number of block types in the palette
+	 * @return Palette size
+	 */
+	size_t GetPaletteSize() const;
+
+	/**
+	 * @brief Gets the number of bytes used by this storage
+	 * @return Memory usage in bytes
+	 */
+	size_t GetMemoryUsage() const;
+
+	/**
+	 * @brief Appends the palette and packed data of this storage to the buffer
+	 * @param[out] buffer Buffer to append to
+	 */
+	void Serialize(std::vector<uint8_t>& buffer) const;
+
+	/**
+	 * @brief Replaces the contents of this storage with serialized data.
+	 * The data is validated, and the storage is left cleared if it is malformed.
+	 * @param[in] data Serialized data
+	 * @param[in] size Number of bytes available in the data
+	 * @return Number of bytes read. Returns 0 if the data is malformed.
+	 */
+	size_t Deserialize(const uint8_t* data, const size_t& size);
+
+	/**
+	 * @brief Appends the palette and the run-length encoded palette indices of this storage to the buffer.
+	 * This is smaller than the serialized form for terrain, but slower to read back.
+	 * @param[out] buffer Buffer to append to
+	 */
+	void EncodeRuns(std::vector<uint8_t>& buffer) const;
+
+	/**
+	 * @brief Replaces the contents of this storage with run-length encoded data.
+	 * The data is validated, and the storage is left cleared if it is malformed.
+	 * @param[in] data Encoded data
+	 * @param[in] size Number of bytes available in the data
+	 * @return Number of bytes read. Returns 0 if the data is malformed.
+	 */
+	size_t DecodeRuns(const uint8_t* data, const size_t& size);
+
+	/**
+	 * @brief Gets a hash of the palette and packed data of this storage.
+	 * Storages with the same blocks only get the same hash if their palettes are in the same order.
+	 * @return Content hash
+	 */
+	uint64_t GetContentHash() const;
+
+	/**
+	 * @brief Checks whether this storage has the same palette and packed data as another storage
+	 * @param[in] other Storage to compare with
+	 * @return True if both storages have the same content
+	 */
+	bool HasSameContent(const BlockStorage& other) const;
+
+private:
+	/**
+	 * @brief Gets the palette index of the specified block type, adding it to the palette if needed
+	 * @param[in] type Block type
+	 * @return Palette index of the block type
+	 */
+	uint32_t GetOrAddPaletteIndex(const BlockTypeEnum& type);
+
+	/**
+	 * @brief Repacks the data with a different number of bits per entry
+	 * @param[in] bitsPerEntry New number of bits per entry
+	 */
+	void Repack(const uint32_t& bitsPerEntry);
+
+	/**
+	 * @brief Gets the palette index at the specified entry index
+	 * @param[in] index Entry index
+	 * @return Palette index
+	 */
+	uint32_t GetPaletteIndex(const uint32_t& index) const;
+
+	/**
+	 * @brief Sets the palette index at the specified entry index
+	 * @param[in] index Entry index
+	 * @param[in] paletteIndex Palette index
+	 */
+	void SetPaletteIndex(const uint32_t& index, const uint32_t& paletteIndex);
+};
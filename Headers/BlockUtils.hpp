@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Enums/BlockFaceEnum.hpp"
+#include "Enums/BlockTypeEnum.hpp"
 
 #include <glm/glm.hpp>
 
@@ -32,4 +33,18 @@ public:
      * @return Normal of the specified block face
      */
     static glm::vec3 GetNormalFromFace(const BlockFaceEnum &face);
+
+    /**
+     * @brief Checks whether the specified block type is solid. Solid blocks hide the faces of the blocks next to them.
+     * @param[in] type Block type
+     * @return True if the block type is solid
+     */
+    static bool IsSolid(const BlockTypeEnum &type);
+
+    /**
+     * @brief Checks whether the specified block type is a liquid
+     * @param[in] type Block type
+     * @return True if the block type is a liquid
+     */
+    static bool IsLiquid(const BlockTypeEnum &type);
 };
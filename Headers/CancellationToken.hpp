@@ -0,0 +1,40 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+/**
+ * Flag shared by the copies of a token, used to tell work that was handed out that it is no longer needed.
+ * Work should check the token between steps and stop once it is cancelled.
+ * Copies can be checked and cancelled from any thread.
+ */
+class CancellationToken
+{
+private:
+	/**
+	 * Flag shared by every copy of the token
+	 */
+	std::shared_ptr<std::atomic<bool>> m_isCancelled;
+
+public:
+	/**
+	 * @brief Constructor. Creates a token that is not cancelled.
+	 */
+	CancellationToken();
+
+	/**
+	 * @brief Destructor
+	 */
+	~CancellationToken();
+
+	/**
+	 * @brief Cancels this token and every copy of it
+	 */
+	void Cancel();
+
+	/**
+	 * @brief Checks whether this token was cancelled
+	 * @return True if the token was cancelled
+	 */
+	bool IsCancelled() const;
+};
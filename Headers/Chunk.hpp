@@ -2,9 +2,25 @@
 
 #include <FastNoiseLite/FastNoiseLite.h>
 
-#include "Block.hpp"
 #include "Camera.hpp"
+#include "CancellationToken.hpp"
+#include "ChunkEditJournal.hpp"
+#include "ChunkSection.hpp"
+#include "ChunkSnapshot.hpp"
+#include "Constants.hpp"
+#include "Enums/BlockTypeEnum.hpp"
+#include "Enums/ChunkNeighborEnum.hpp"
+#include "Enums/ChunkStateEnum.hpp"
+#include "GLDeletionQueue.hpp"
+#include "MemoryReport.hpp"
 #include "Mesh.hpp"
+#include "SharedSectionTable.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
 
 /**
  * Chunk class
@@ -23,28 +39,107 @@ private:
 	Mesh m_waterMesh;
 
 	/**
-	 * Block data
+	 * Block data, split into vertical sections.
+	 * An entry is nullptr if that section only contains air.
+	 * Sections can be shared with snapshots, and are copied before being modified while shared.
+	 */
+	std::array<std::shared_ptr<ChunkSection>, Constants::CHUNK_SECTION_COUNT> m_sections;
+
+	/**
+	 * Sections that were released and can be reused without allocating.
+	 * Never holds sections registered in the shared section table.
+	 */
+	std::vector<std::shared_ptr<ChunkSection>> m_spareSections;
+
+	/**
+	 * Height of each column, which is the y-coordinate of its topmost non-air block plus one.
+	 * A value of 0 means the column only contains air. Stored row by row along the z-axis.
+	 */
+	std::array<uint16_t, Constants::CHUNK_WIDTH * Constants::CHUNK_DEPTH> m_heightMap;
+
+	/**
+	 * Lower bound of the y-coordinate of the lowest non-air block in this chunk
+	 */
+	int m_minHeight;
+
+	/**
+	 * Height of the tallest column in this chunk
 	 */
-	std::vector<Block*> m_blocks;
+	int m_maxHeight;
 
 	/**
 	 * Chunk indices in each axis
 	 */
 	glm::ivec3 m_chunkIndex;
 
+	/**
+	 * Neighboring chunks. An entry is nullptr if that neighbor is not loaded.
+	 */
+	std::array<Chunk*, static_cast<size_t>(ChunkNeighborEnum::COUNT)> m_neighbors;
+
+	/**
+	 * Version of the block data. Incremented whenever a block changes or the chunk gets reset.
+	 */
+	uint64_t m_version;
+
+	/**
+	 * Version of the block data when it was last saved or generated
+	 */
+	uint64_t m_savedVersion;
+
+	/**
+	 * Block changes made since the terrain was generated
+	 */
+	ChunkEditJournal m_editJournal;
+
+	/**
+	 * Whether block changes are recorded in the edit journal
+	 */
+	bool m_isRecordingEdits;
+
+	/**
+	 * Run-length encoded block data while the block data is compressed
+	 */
+	std::vector<uint8_t> m_compressedBlockData;
+
+	/**
+	 * Whether the block data is compressed. The sections are released while the block data is compressed.
+	 */
+	bool m_isBlockDataCompressed;
+
+	/**
+	 * Current stage of the lifecycle of this chunk. Advanced by the job system threads while the chunk is generated.
+	 */
+	std::atomic<ChunkStateEnum> m_state;
+
+	/**
+	 * Token handed to work done for this chunk. Cancelled when the chunk starts unloading.
+	 */
+	CancellationToken m_cancellationToken;
+
 public:
 	/**
 	 * @brief Constructor
 	 * @param[in] chunkIndexX Chunk x-index
+	 * @param[in] chunkIndexY Chunk y-index
 	 * @param[in] chunkIndexZ Chunk z-index
 	 */
-	Chunk(const int& chunkIndexX, const int& chunkIndexZ);
+	Chunk(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ);
 
 	/**
 	 * @brief Destructor
 	 */
 	~Chunk();
 
+	/**
+	 * @brief Resets this chunk to an empty chunk at the provided location indices,
+	 * keeping its allocated sections, mesh buffers and GL objects for reuse
+	 * @param[in] chunkIndexX Chunk x-index
+	 * @param[in] chunkIndexY Chunk y-index
+	 * @param[in] chunkIndexZ Chunk z-index
+	 */
+	void Reset(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ);
+
 	/**
 	 * @brief Gets the x chunk index for this chunk
 	 * @return Chunk x-index
@@ -69,11 +164,48 @@ public:
 	 */
 	glm::ivec3 GetChunkIndices() const;
 
+	/**
+	 * @brief Gets the neighboring chunk in the specified direction
+	 * @param[in] neighbor Direction of the neighbor
+	 * @return Neighboring chunk. Returns nullptr if the neighbor is not loaded.
+	 */
+	Chunk* GetNeighbor(const ChunkNeighborEnum& neighbor) const;
+
+	/**
+	 * @brief Sets the neighboring chunk in the specified direction
+	 * @param[in] neighbor Direction of the neighbor
+	 * @param[in] chunk Neighboring chunk. Can be set to nullptr if the neighbor got unloaded.
+	 */
+	void SetNeighbor(const ChunkNeighborEnum& neighbor, Chunk* chunk);
+
 	/**
 	 * @brief Generates the mesh for this chunk
 	 */
 	void GenerateMesh();
 
+	/**
+	 * @brief Fills the vertex and index lists of the meshes from the block data without touching the GPU.
+	 * Only reads this chunk, so it can run on a worker thread while no other thread uses the chunk.
+	 */
+	void BuildMeshes();
+
+	/**
+	 * @brief Clears the vertex and index lists of the meshes, before they are built again one section at a time
+	 */
+	void ClearMeshData();
+
+	/**
+	 * @brief Adds the faces of one section to the vertex and index lists of the meshes.
+	 * Building every section in order after ClearMeshData() gives the same meshes as BuildMeshes().
+	 * @param[in] sectionIndex Index of the section
+	 */
+	void BuildSectionMeshes(const int& sectionIndex);
+
+	/**
+	 * @brief Uploads the vertex and index lists built by BuildMeshes() to the GPU. Has to run on the thread with the GL context.
+	 */
+	void UploadMeshes();
+
 	/**
 	 * @brief Gets the mesh for the terrain
 	 * @return Terrain mesh
@@ -91,16 +223,301 @@ public:
 	 * @param[in] x X-coordinate
 	 * @param[in] y Y-coordinate
 	 * @param[in] z z-coordinate
-	 * @return Block data of the block at the specified location
+	 * @return Type of the block at the specified location
+	 */
+	BlockTypeEnum GetBlockAt(int x, int y, int z) const;
+
+	/**
+	 * @brief Checks whether the block at the specified location is solid
+	 * @param[in] x X-coordinate
+	 * @param[in] y Y-coordinate
+	 * @param[in] z z-coordinate
+	 * @return True if the block is solid
+	 */
+	bool IsSolidAt(const int& x, const int& y, const int& z) const;
+
+	/**
+	 * @brief Checks whether the block at the specified location is a liquid
+	 * @param[in] x X-coordinate
+	 * @param[in] y Y-coordinate
+	 * @param[in] z z-coordinate
+	 * @return True if the block is a liquid
 	 */
-	Block* GetBlockAt(int x, int y, int z);
+	bool IsLiquidAt(const int& x, const int& y, const int& z) const;
 
 	/**
-	 * @brief Sets the block at the specified location with the specified block
+	 * @brief Sets the block at the specified location with the specified block type
 	 * @param[in] x X-coordinate
 	 * @param[in] y Y-coordinate
 	 * @param[in] z z-coordinate
-	 * @param[in] block Data for the new block. Can be set to nullptr if it's an air block.
+	 * @param[in] type Type of the new block. Can be set to BlockTypeEnum::AIR to remove the block.
+	 */
+	void SetBlockAt(const int& x, const int& y, const int& z, const BlockTypeEnum& type);
+
+	/**
+	 * @brief Gets the height of the specified column, which is the y-coordinate of its topmost non-air block plus one
+	 * @param[in] x X-coordinate
+	 * @param[in] z Z-coordinate
+	 * @return Height of the column. Returns 0 if the column only contains air.
+	 */
+	int GetHeightAt(const int& x, const int& z) const;
+
+	/**
+	 * @brief Gets a lower bound of the y-coordinate of the lowest non-air block in this chunk.
+	 * Every block below this height is air.
+	 * @return Lower bound of the lowest non-air block. Returns Constants::CHUNK_HEIGHT if the chunk is empty.
+	 */
+	int GetMinHeight() const;
+
+	/**
+	 * @brief Gets the height of the tallest column in this chunk. Every block at or above this height is air.
+	 * @return Height of the tallest column
+	 */
+	int GetMaxHeight() const;
+
+	/**
+	 * @brief Gets the section at the specified section index
+	 * @param[in] sectionIndex Section index
+	 * @return Section at the specified index. Returns nullptr if the section only contains air.
+	 */
+	const ChunkSection* GetSection(const int& sectionIndex) const;
+
+	/**
+	 * @brief Gets the number of sections that contain at least one non-air block
+	 * @return Number of allocated sections
+	 */
+	int GetAllocatedSectionCount() const;
+
+	/**
+	 * @brief Compacts the block storage of every section.
+	 * Should be called after bulk modifications such as world generation.
+	 */
+	void CompactSections();
+
+	/**
+	 * @brief Replaces sections with identical sections already used by other chunks.
+	 * Should be called after CompactSections(), since only sections packed the same way can be matched.
+	 * @param[in] sharedSections Table of sections that can be shared
+	 */
+	void ShareSections(SharedSectionTable& sharedSections);
+
+	/**
+	 * @brief Gets the number of bytes used by the block data of this chunk.
+	 * Sections shared with other chunks or snapshots are split evenly between their users.
+	 * @return Block data memory usage in bytes
+	 */
+	size_t GetBlockMemoryUsage() const;
+
+	/**
+	 * @brief Gets the number of bytes used by this chunk, broken down into block data, meshes and bookkeeping
+	 * @return Memory usage
+	 */
+	MemoryUsage GetMemoryUsage() const;
+
+	/**
+	 * @brief Deletes the GPU buffers and frees the vertex lists of the meshes.
+	 * GenerateMesh() has to be called before the chunk is drawn again.
+	 */
+	void ReleaseMeshes();
+
+	/**
+	 * @brief Hands the GPU buffers of the meshes over to the deletion queue, so that the chunk
+	 * can be deleted on a thread without a GL context
+	 * @param[in] deletionQueue Queue that deletes the buffers on the render thread
+	 */
+	void DeferMeshBufferDeletion(GLDeletionQueue& deletionQueue);
+
+	/**
+	 * @brief Checks whether the meshes have been generated and uploaded
+	 * @return True if the meshes are ready to be drawn
+	 */
+	bool HasMeshes() const;
+
+	/**
+	 * @brief Run-length encodes the block data into a compact buffer and frees the sections.
+	 * Blocks cannot be accessed until DecompressBlockData() is called.
+	 */
+	void CompressBlockData();
+
+	/**
+	 * @brief Restores the sections from the compressed block data
+	 */
+	void DecompressBlockData();
+
+	/**
+	 * @brief Checks whether the block data is compressed
+	 * @return True if the block data is compressed
+	 */
+	bool IsBlockDataCompressed() const;
+
+	/**
+	 * @brief Releases the meshes and compresses the block data, keeping the chunk in memory
+	 * so that it can be brought back without generating its terrain again
+	 */
+	void Hibernate();
+
+	/**
+	 * @brief Checks whether the chunk is hibernated
+	 * @return True if the block data is compressed and the meshes are released
+	 */
+	bool IsHibernated() const;
+
+	/**
+	 * @brief Gets the current stage of the lifecycle of this chunk
+	 * @return Chunk state
+	 */
+	ChunkStateEnum GetState() const;
+
+	/**
+	 * @brief Moves the chunk to another stage of its lifecycle.
+	 * Entering ChunkStateEnum::UNLOADING cancels the cancellation token,
+	 * and leaving it gives the chunk a new token.
+	 * @param[in] state New state
+	 */
+	void SetState(const ChunkStateEnum& state);
+
+	/**
+	 * @brief Moves the chunk to the next stage of its lifecycle, unless it left the expected stage in the meantime.
+	 * Can be called from the job system threads, even while the main thread starts unloading the chunk.
+	 * @param[in] expectedState Stage the chunk should be in
+	 * @param[in] state New state
+	 * @return True if the state was changed, false if the chunk was not in the expected stage
+	 */
+	bool AdvanceState(const ChunkStateEnum& expectedState, const ChunkStateEnum& state);
+
+	/**
+	 * @brief Gets the token that work for this chunk should check to find out whether it is still needed
+	 * @return Copy of the cancellation token of the chunk
+	 */
+	CancellationToken GetCancellationToken() const;
+
+	/**
+	 * @brief Gets the version of the block data, which is incremented whenever a block changes or the chunk gets reset
+	 * @return Chunk version
+	 */
+	uint64_t GetVersion() const;
+
+	/**
+	 * @brief Creates an immutable snapshot of the block data that can be read from other threads.
+	 * Sections are shared with the snapshot instead of being copied.
+	 * @return Snapshot of the current block data
+	 */
+	ChunkSnapshot CreateSnapshot() const;
+
+	/**
+	 * @brief Checks whether the snapshot still matches the current block data of this chunk.
+	 * Results computed from a stale snapshot should be discarded.
+	 * @param[in] snapshot Snapshot to check
+	 * @return Returns true if the snapshot was taken from this chunk at its current version
+	 */
+	bool IsSnapshotCurrent(const ChunkSnapshot& snapshot) const;
+
+	/**
+	 * @brief Checks whether the block data changed since it was last saved or generated
+	 * @return True if the block data has changes that would be lost when the chunk is unloaded
+	 */
+	bool HasUnsavedChanges() const;
+
+	/**
+	 * @brief Marks the current block data as persisted, either because it was saved
+	 * or because it can be generated again from the world generation parameters
+	 */
+	void MarkSaved();
+
+	/**
+	 * @brief Marks the block data as not persisted, so that the chunk is saved again.
+	 * Used when writing the saved data failed.
+	 */
+	void MarkUnsaved();
+
+	/**
+	 * @brief Appends the block data of this chunk to the buffer
+	 * @param[out] buffer Buffer to append to
+	 */
+	void Serialize(std::vector<uint8_t>& buffer) const;
+
+	/**
+	 * @brief Loads serialized block data into this chunk, which should be empty.
+	 * The data is validated, and the chunk is left empty if it is malformed.
+	 * @param[in] data Serialized data
+	 * @param[in] size Number of bytes available in the data
+	 * @return True if the data was loaded, false if it is malformed
+	 */
+	bool Deserialize(const uint8_t* data, const size_t& size);
+
+	/**
+	 * @brief Clears the edit journal and starts recording block changes in it.
+	 * Should be called right after the terrain of this chunk is generated.
+	 */
+	void StartRecordingEdits();
+
+	/**
+	 * @brief Checks whether block changes are recorded in the edit journal.
+	 * Chunks loaded from complete block data do not record edits.
+	 * @return True if block changes are recorded
+	 */
+	bool IsRecordingEdits() const;
+
+	/**
+	 * @brief Gets the journal of block changes made since the terrain was generated
+	 * @return Edit journal
+	 */
+	const ChunkEditJournal& GetEditJournal() const;
+
+	/**
+	 * @brief Compacts the edit journal
+	 */
+	void CompactEditJournal();
+
+private:
+	/**
+	 * @brief Gets a word of the solid block mask
+	 * @param[in] y Y-coordinate. Returns 0 if it is outside of the chunk.
+	 * @param[in] zGroup Z-coordinate divided by 4. Returns 0 if it is outside of the chunk.
+	 * @return Solid block bits of four rows along the x-axis, laid out like in ChunkSection
+	 */
+	uint64_t GetSolidMaskWord(const int& y, const int& zGroup) const;
+
+	/**
+	 * @brief Gets a word of the liquid block mask
+	 * @param[in] y Y-coordinate. Returns 0 if it is outside of the chunk.
+	 * @param[in] zGroup Z-coordinate divided by 4. Returns 0 if it is outside of the chunk.
+	 * @return Liquid block bits of four rows along the x-axis, laid out like in ChunkSection
+	 */
+	uint64_t GetLiquidMaskWord(const int& y, const int& zGroup) const;
+
+	/**
+	 * @brief Gets an empty section, reusing a spare section if there is one
+	 * @return Empty section
+	 */
+	std::shared_ptr<ChunkSection> AcquireSection();
+
+	/**
+	 * @brief Removes the section at the specified index, keeping it as a spare section
+	 * if no snapshot shares it and it is not registered in the shared section table
+	 * @param[in] sectionIndex Section index
+	 */
+	void ReleaseSection(const int& sectionIndex);
+
+	/**
+	 * @brief Gets the section at the specified index for modification,
+	 * copying it first if it is shared with a snapshot or registered in the shared section table
+	 * @param[in] sectionIndex Section index
+	 * @return Section that is only referenced by this chunk
+	 */
+	ChunkSection* GetWritableSection(const int& sectionIndex);
+
+	/**
+	 * @brief Updates the height map and height bounds after a block was set
+	 * @param[in] x X-coordinate
+	 * @param[in] y Y-coordinate
+	 * @param[in] z Z-coordinate
+	 * @param[in] type Type of the new block
+	 */
+	void UpdateHeights(const int& x, const int& y, const int& z, const BlockTypeEnum& type);
+
+	/**
+	 * @brief Recomputes the height map and height bounds from the block data
 	 */
-	void SetBlockAt(const int& x, const int& y, const int& z, Block* block);
+	void RecalculateHeights();
 };
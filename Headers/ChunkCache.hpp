@@ -0,0 +1,237 @@
+#pragma once
+
+#include "Chunk.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Memory-budgeted cache of chunks that left the loaded area, so that
+ * coming back to them does not require generating and meshing them again.
+ * When the cache is over budget, the least recently used chunks first lose their meshes,
+ * then get hibernated with their block data compressed, and are finally evicted.
+ */
+class ChunkCache
+{
+private:
+	/**
+	 * Lookup entry of a cached chunk
+	 */
+	struct Entry
+	{
+		/**
+		 * Position of the chunk in the list of cached chunks
+		 */
+		std::list<Chunk*>::iterator position;
+
+		/**
+		 * Number of bytes the chunk was charged for when it was last measured.
+		 * Kept because the memory usage of a chunk changes as other chunks start or stop sharing its sections.
+		 */
+		size_t chargedBytes;
+	};
+
+	/**
+	 * Cached chunks, from the most recently used to the least recently used
+	 */
+	std::list<Chunk*> m_chunks;
+
+	/**
+	 * Entries of the cached chunks, keyed by their packed chunk indices
+	 */
+	std::unordered_map<uint64_t, Entry> m_chunkMap;
+
+	/**
+	 * Maximum number of bytes the cached chunks can use
+	 */
+	size_t m_budget;
+
+	/**
+	 * Number of bytes used by the cached chunks
+	 */
+	size_t m_residentBytes;
+
+	/**
+	 * Number of lookups that found the chunk in the cache
+	 */
+	uint64_t m_numHits;
+
+	/**
+	 * Number of lookups that did not find the chunk in the cache
+	 */
+	uint64_t m_numMisses;
+
+	/**
+	 * Number of times a chunk was hibernated
+	 */
+	uint64_t m_numHibernations;
+
+	/**
+	 * Total block data bytes of chunks right before they were hibernated
+	 */
+	uint64_t m_numBytesBeforeHibernation;
+
+	/**
+	 * Total block data bytes of chunks right after they were hibernated
+	 */
+	uint64_t m_numBytesAfterHibernation;
+
+	/**
+	 * Number of chunks that had to be decompressed or meshed again when they were taken out of the cache
+	 */
+	uint64_t m_numRehydrations;
+
+	/**
+	 * Total time spent bringing chunks back from the cache, in milliseconds
+	 */
+	double m_totalRehydrationTime;
+
+	/**
+	 * Longest time spent bringing a single chunk back from the cache, in milliseconds
+	 */
+	float m_maxRehydrationTime;
+
+public:
+	/**
+	 * @brief Constructor
+	 * @param[in] budget Maximum number of bytes the cached chunks can use
+	 */
+	ChunkCache(const size_t& budget);
+
+	/**
+	 * @brief Destructor. Deletes every chunk that is still in the cache.
+	 */
+	~ChunkCache();
+
+	/**
+	 * @brief Adds the chunk to the cache as the most recently used chunk.
+	 * The chunk should already be removed from the world.
+	 * @param[in] chunk Chunk to add
+	 */
+	void Insert(Chunk* chunk);
+
+	/**
+	 * @brief Removes the chunk at the provided location indices from the cache
+	 * @param[in] chunkIndexX Chunk x-index
+	 * @param[in] chunkIndexY Chunk y-index
+	 * @param[in] chunkIndexZ Chunk z-index
+	 * @return Chunk at the provided location. Returns nullptr if the chunk is not in the cache.
+	 */
+	Chunk* Take(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ);
+
+	/**
+	 * @brief Gets the chunk at the provided location indices without removing it from the cache or counting a hit or a miss
+	 * @param[in] chunkIndexX Chunk x-index
+	 * @param[in] chunkIndexY Chunk y-index
+	 * @param[in] chunkIndexZ Chunk z-index
+	 * @return Chunk at the provided location. Returns nullptr if the chunk is not in the cache.
+	 */
+	Chunk* Find(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ) const;
+
+	/**
+	 * @brief Shrinks the least recently used chunks until the cache fits in its budget
+	 * @param[out] evictedChunks Chunks that had to be removed from the cache. The caller takes ownership of these chunks.
+	 */
+	void EnforceBudget(std::vector<Chunk*>& evictedChunks);
+
+	/**
+	 * @brief Removes every chunk from the cache
+	 * @param[out] removedChunks Chunks that were in the cache. The caller takes ownership of these chunks.
+	 */
+	void Clear(std::vector<Chunk*>& removedChunks);
+
+	/**
+	 * @brief Gets the cached chunks
+	 * @return Cached chunks, from the most recently used to the least recently used
+	 */
+	const std::list<Chunk*>& GetChunks() const;
+
+	/**
+	 * @brief Sets the maximum number of bytes the cached chunks can use.
+	 * Takes effect on the next call to EnforceBudget().
+	 * @param[in] budget Budget in bytes
+	 */
+	void SetBudget(const size_t& budget);
+
+	/**
+	 * @brief Gets the maximum number of bytes the cached chunks can use
+	 * @return Budget in bytes
+	 */
+	size_t GetBudget() const;
+
+	/**
+	 * @brief Gets the number of bytes used by the cached chunks
+	 * @return Resident bytes
+	 */
+	size_t GetResidentBytes() const;
+
+	/**
+	 * @brief Gets the number of chunks in the cache
+	 * @return Number of cached chunks
+	 */
+	size_t GetCachedChunkCount() const;
+
+	/**
+	 * @brief Gets the number of lookups that found the chunk in the cache
+	 * @return Number of cache hits
+	 */
+	uint64_t GetHitCount() const;
+
+	/**
+	 * @brief Gets the number of lookups that did not find the chunk in the cache
+	 * @return Number of cache misses
+	 */
+	uint64_t GetMissCount() const;
+
+	/**
+	 * @brief Gets the fraction of lookups that found the chunk in the cache
+	 * @return Hit rate between 0 and 1. Returns 0 if there were no lookups.
+	 */
+	float GetHitRate() const;
+
+	/**
+	 * @brief Gets the number of cached chunks that are hibernated
+	 * @return Number of hibernated chunks
+	 */
+	size_t GetHibernatedChunkCount() const;
+
+	/**
+	 * @brief Gets how much hibernation shrinks the block data of a chunk on average
+	 * @return Block data size before hibernation divided by the size after. Returns 0 if no chunk was hibernated yet.
+	 */
+	float GetCompressionRatio() const;
+
+	/**
+	 * @brief Records the time it took to bring back a chunk that had been shrunk in the cache
+	 * @param[in] milliseconds Time spent decompressing and meshing the chunk
+	 */
+	void RecordRehydration(const float& milliseconds);
+
+	/**
+	 * @brief Gets the number of chunks that had to be decompressed or meshed again when they were taken out of the cache
+	 * @return Number of rehydrated chunks
+	 */
+	uint64_t GetRehydrationCount() const;
+
+	/**
+	 * @brief Gets the average time it took to bring back a chunk that had been shrunk in the cache
+	 * @return Average rehydration time in milliseconds. Returns 0 if no chunk was rehydrated yet.
+	 */
+	float GetAverageRehydrationTime() const;
+
+	/**
+	 * @brief Gets the longest time it took to bring back a chunk that had been shrunk in the cache
+	 * @return Maximum rehydration time in milliseconds
+	 */
+	float GetMaxRehydrationTime() const;
+
+private:
+	/**
+	 * @brief Measures the memory usage of a cached chunk again after it was shrunk
+	 * @param[in] chunk Cached chunk
+	 */
+	void UpdateChargedBytes(Chunk* chunk);
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Chunk.hpp"
+
+#include <cstddef>
+
+/**
+ * Base class for a container that looks up loaded chunks by their chunk indices
+ */
+class BaseChunkContainer
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	BaseChunkContainer()
+	{
+	}
+
+	/**
+	 * @brief Destructor
+	 */
+	virtual ~BaseChunkContainer()
+	{
+	}
+
+	/**
+	 * @brief Gets the chunk at the provided location indices
+	 * @param[in] chunkIndexX Chunk x-index
+	 * @param[in] chunkIndexY Chunk y-index
+	 * @param[in] chunkIndexZ Chunk z-index
+	 * @return Chunk at the provided location. Returns nullptr if there is no chunk at that location.
+	 */
+	virtual Chunk* Get(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ) const = 0;
+
+	/**
+	 * @brief Adds the chunk to the container
+	 * @param[in] chunk Chunk to add
+	 * @return True if the chunk was added, false if the container has no room for it
+	 */
+	virtual bool Add(Chunk* chunk) = 0;
+
+	/**
+	 * @brief Removes the chunk from the container
+	 * @param[in] chunk Chunk to remove
+	 */
+	virtual void Remove(Chunk* chunk) = 0;
+
+	/**
+	 * @brief Removes all chunks from the container
+	 */
+	virtual void Clear() = 0;
+
+	/**
+	 * @brief Gets the number of bytes used by the container itself, not counting the chunks
+	 * @return Memory usage in bytes
+	 */
+	virtual size_t GetMemoryUsage() const = 0;
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "ChunkContainers/BaseChunkContainer.hpp"
+
+#include <cstdint>
+#include <unordered_map>
+
+/**
+ * Chunk container that looks chunks up in a hash map keyed on the packed chunk indices
+ */
+class HashMapChunkContainer : public BaseChunkContainer
+{
+private:
+	/**
+	 * Mapping of packed chunk indices to the corresponding chunk
+	 */
+	std::unordered_map<uint64_t, Chunk*> m_chunkMap;
+
+public:
+	/**
+	 * @brief Constructor
+	 */
+	HashMapChunkContainer();
+
+	/**
+	 * @brief Destructor
+	 */
+	~HashMapChunkContainer();
+
+	/**
+	 * @brief Gets the chunk at the provided location indices
+	 * @param[in] chunkIndexX Chunk x-index
+	 * @param[in] chunkIndexY Chunk y-index
+	 * @param[in] chunkIndexZ Chunk z-index
+	 * @return Chunk at the provided location. Returns nullptr if there is no chunk at that location.
+	 */
+	Chunk* Get(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ) const override;
+
+	/**
+	 * @brief Adds the chunk to the container
+	 * @param[in] chunk Chunk to add
+	 * @return True if the chunk was added, false if the container has no room for it
+	 */
+	bool Add(Chunk* chunk) override;
+
+	/**
+	 * @brief Removes the chunk from the container
+	 * @param[in] chunk Chunk to remove
+	 */
+	void Remove(Chunk* chunk) override;
+
+	/**
+	 * @brief Removes all chunks from the container
+	 */
+	void Clear() override;
+
+	/**
+	 * @brief Gets the number of bytes used by the container itself, not counting the chunks
+	 * @return Memory usage in bytes
+	 */
+	size_t GetMemoryUsage() const override;
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "ChunkContainers/BaseChunkContainer.hpp"
+
+#include <vector>
+
+/**
+ * Chunk container that stores chunks in a fixed-size toroidal grid.
+ * A chunk is stored in the slot given by its chunk indices modulo the grid size,
+ * so any box that is at most the grid size wide and tall maps to distinct slots.
+ * When the loaded area shifts by one chunk, only one layer of slots changes owner.
+ */
+class RingBufferChunkContainer : public BaseChunkContainer
+{
+private:
+	/**
+	 * Grid slots, stored row by row along the z-axis and layer by layer along the y-axis
+	 */
+	std::vector<Chunk*> m_slots;
+
+	/**
+	 * Number of slots along each horizontal axis
+	 */
+	int m_size;
+
+	/**
+	 * Number of slots along the y-axis
+	 */
+	int m_height;
+
+public:
+	/**
+	 * @brief Constructor
+	 * @param[in] radius Horizontal radius in chunks of the loaded area. The grid is (2 * radius + 1) slots wide.
+	 * @param[in] verticalRadius Vertical radius in chunks of the loaded area. The grid is (2 * verticalRadius + 1) slots tall.
+	 */
+	RingBufferChunkContainer(const int& radius, const int& verticalRadius);
+
+	/**
+	 * @brief Destructor
+	 */
+	~RingBufferChunkContainer();
+
+	/**
+	 * @brief Gets the chunk at the provided location indices
+	 * @param[in] chunkIndexX Chunk x-index
+	 * @param[in] chunkIndexY Chunk y-index
+	 * @param[in] chunkIndexZ Chunk z-index
+	 * @return Chunk at the provided location. Returns nullptr if there is no chunk at that location.
+	 */
+	Chunk* Get(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ) const override;
+
+	/**
+	 * @brief Adds the chunk to the container
+	 * @param[in] chunk Chunk to add
+	 * @return True if the chunk was added, false if its slot is still occupied by another chunk
+	 */
+	bool Add(Chunk* chunk) override;
+
+	/**
+	 * @brief Removes the chunk from the container
+	 * @param[in] chunk Chunk to remove
+	 */
+	void Remove(Chunk* chunk) override;
+
+	/**
+	 * @brief Removes all chunks from the container
+	 */
+	void Clear() override;
+
+	/**
+	 * @brief Gets the number of bytes used by the container itself, not counting the chunks
+	 * @return Memory usage in bytes
+	 */
+	size_t GetMemoryUsage() const override;
+
+private:
+	/**
+	 * @brief Gets the slot index for the provided location indices
+	 * @param[in] chunkIndexX Chunk x-index
+	 * @param[in] chunkIndexY Chunk y-index
+	 * @param[in] chunkIndexZ Chunk z-index
+	 * @return Slot index
+	 */
+	size_t GetSlotIndex(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ) const;
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "ChunkContainers/BaseChunkContainer.hpp"
+
+#include <vector>
+
+/**
+ * Chunk container that searches a list of chunks linearly
+ */
+class VectorChunkContainer : public BaseChunkContainer
+{
+private:
+	/**
+	 * List of chunks
+	 */
+	std::vector<Chunk*> m_chunks;
+
+public:
+	/**
+	 * @brief Constructor
+	 */
+	VectorChunkContainer();
+
+	/**
+	 * @brief Destructor
+	 */
+	~VectorChunkContainer();
+
+	/**
+	 * @brief Gets the chunk at the provided location indices
+	 * @param[in] chunkIndexX Chunk x-index
+	 * @param[in] chunkIndexY Chunk y-index
+	 * @param[in] chunkIndexZ Chunk z-index
+	 * @return Chunk at the provided location. Returns nullptr if there is no chunk at that location.
+	 */
+	Chunk* Get(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ) const override;
+
+	/**
+	 * @brief Adds the chunk to the container
+	 * @param[in] chunk Chunk to add
+	 * @return True if the chunk was added, false if the container has no room for it
+	 */
+	bool Add(Chunk* chunk) override;
+
+	/**
+	 * @brief Removes the chunk from the container
+	 * @param[in] chunk Chunk to remove
+	 */
+	void Remove(Chunk* chunk) override;
+
+	/**
+	 * @brief Removes all chunks from the container
+	 */
+	void Clear() override;
+
+	/**
+	 * @brief Gets the number of bytes used by the container itself, not counting the chunks
+	 * @return Memory usage in bytes
+	 */
+	size_t GetMemoryUsage() const override;
+};
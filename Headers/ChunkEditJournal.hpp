@@ -0,0 +1,137 @@
+#pragma once
+
+#include "Enums/BlockTypeEnum.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Record of the block changes made to a chunk after its terrain was generated.
+ * Since terrain can be generated again from the world generation parameters,
+ * saving the journal is enough to restore an edited chunk.
+ */
+class ChunkEditJournal
+{
+public:
+	/**
+	 * Single block change
+	 */
+	struct Entry
+	{
+		/**
+		 * Position of the block within the chunk, packed as (y << 8) | (z << 4) | x
+		 */
+		uint16_t packedPosition;
+
+		/**
+		 * Type of the block before it was first changed
+		 */
+		BlockTypeEnum baseType;
+
+		/**
+		 * Type of the block after the change
+		 */
+		BlockTypeEnum type;
+	};
+
+private:
+	/**
+	 * Block changes in the order they were made
+	 */
+	std::vector<Entry> m_entries;
+
+	/**
+	 * Number of entries right after the last compaction
+	 */
+	size_t m_numCompactedEntries;
+
+public:
+	/**
+	 * @brief Constructor
+	 */
+	ChunkEditJournal();
+
+	/**
+	 * @brief Destructor
+	 */
+	~ChunkEditJournal();
+
+	/**
+	 * @brief Records a block change.
+	 * The journal is compacted once it has grown to twice its compacted size.
+	 * @param[in] x X-coordinate
+	 * @param[in] y Y-coordinate
+	 * @param[in] z Z-coordinate
+	 * @param[in] oldType Type of the block before the change
+	 * @param[in] newType Type of the block after the change
+	 */
+	void Append(const int& x, const int& y, const int& z, const BlockTypeEnum& oldType, const BlockTypeEnum& newType);
+
+	/**
+	 * @brief Merges entries for the same block into one, and drops blocks that were changed back to their generated type
+	 */
+	void Compact();
+
+	/**
+	 * @brief Removes every entry
+	 */
+	void Clear();
+
+	/**
+	 * @brief Checks whether the journal has no entries
+	 * @return True if the journal has no entries
+	 */
+	bool IsEmpty() const;
+
+	/**
+	 * @brief Gets the entries of the journal
+	 * @return Entries in the order the changes were made
+	 */
+	const std::vector<Entry>& GetEntries() const;
+
+	/**
+	 * @brief Gets the number of bytes the serialized journal takes up
+	 * @return Serialized size in bytes
+	 */
+	size_t GetSerializedSize() const;
+
+	/**
+	 * @brief Gets the number of bytes allocated for the entries
+	 * @return Memory usage in bytes
+	 */
+	size_t GetMemoryUsage() const;
+
+	/**
+	 * @brief Appends the entries of the journal to the buffer
+	 * @param[out] buffer Buffer to append to
+	 */
+	void Serialize(std::vector<uint8_t>& buffer) const;
+
+	/**
+	 * @brief Reads serialized entries without storing them
+	 * @param[in] data Serialized data
+	 * @param[in] size Number of bytes available in the data
+	 * @param[out] entries Entries read from the data
+	 * @return True if the data was read, false if it is malformed
+	 */
+	static bool Deserialize(const uint8_t* data, const size_t& size, std::vector<Entry>& entries);
+
+	/**
+	 * @brief Packs a block position within a chunk
+	 * @param[in] x X-coordinate
+	 * @param[in] y Y-coordinate
+	 * @param[in] z Z-coordinate
+	 * @return Packed position
+	 */
+	static uint16_t PackPosition(const int& x, const int& y, const int& z);
+
+	/**
+	 * @brief Unpacks a block position within a chunk
+	 * @param[in] packedPosition Packed position
+	 * @param[out] x X-coordinate
+	 * @param[out] y Y-coordinate
+	 * @param[out] z Z-coordinate
+	 */
+	static void UnpackPosition(const uint16_t& packedPosition, int& x, int& y, int& z);
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "Chunk.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Pool of chunks that recycles unloaded chunks, including their
+ * block storage, mesh buffers and GL objects, for newly loaded chunks
+ */
+class ChunkPool
+{
+private:
+	/**
+	 * Chunks that are ready to be reused
+	 */
+	std::vector<Chunk*> m_freeChunks;
+
+	/**
+	 * Maximum number of chunks kept in the pool
+	 */
+	size_t m_capacity;
+
+	/**
+	 * Number of acquisitions that reused a pooled chunk
+	 */
+	uint64_t m_numHits;
+
+	/**
+	 * Number of acquisitions that had to allocate a new chunk
+	 */
+	uint64_t m_numMisses;
+
+public:
+	/**
+	 * @brief Constructor
+	 * @param[in] capacity Maximum number of chunks kept in the pool
+	 */
+	ChunkPool(const size_t& capacity);
+
+	/**
+	 * @brief Destructor
+	 */
+	~ChunkPool();
+
+	/**
+	 * @brief Gets an empty chunk at the provided location indices, reusing a pooled chunk if there is one
+	 * @param[in] chunkIndexX Chunk x-index
+	 * @param[in] chunkIndexY Chunk y-index
+	 * @param[in] chunkIndexZ Chunk z-index
+	 * @return Empty chunk
+	 */
+	Chunk* Acquire(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ);
+
+	/**
+	 * @brief Returns the chunk to the pool
+	 * @param[in] chunk Chunk to return
+	 * @return True if the chunk was pooled. Returns false if the pool is full, in which case the caller keeps ownership of the chunk.
+	 */
+	bool Release(Chunk* chunk);
+
+	/**
+	 * @brief Gets the number of chunks currently in the pool
+	 * @return Number of pooled chunks
+	 */
+	size_t GetPooledChunkCount() const;
+
+	/**
+	 * @brief Gets the number of acquisitions that reused a pooled chunk
+	 * @return Number of pool hits
+	 */
+	uint64_t GetHitCount() const;
+
+	/**
+	 * @brief Gets the number of acquisitions that had to allocate a new chunk
+	 * @return Number of pool misses
+	 */
+	uint64_t GetMissCount() const;
+
+	/**
+	 * @brief Gets the number of bytes used by the pooled chunks
+	 * @return Memory usage of the pooled chunks
+	 */
+	MemoryUsage GetMemoryUsage() const;
+};
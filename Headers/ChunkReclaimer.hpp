@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Chunk.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+/**
+ * Deletes unloaded chunks on a background thread, so that freeing their block data
+ * and mesh lists does not stall the frame that unloads them.
+ * Chunks handed to the reclaimer should no longer own any GL objects.
+ */
+class ChunkReclaimer
+{
+private:
+	/**
+	 * Chunks waiting to be deleted
+	 */
+	std::deque<Chunk*> m_pendingChunks;
+
+	/**
+	 * Mutex guarding the pending chunks and the stop flag
+	 */
+	mutable std::mutex m_mutex;
+
+	/**
+	 * Signalled when chunks are added or the reclaimer is stopped
+	 */
+	std::condition_variable m_condition;
+
+	/**
+	 * Flag indicating that the background thread should finish the pending chunks and exit
+	 */
+	bool m_isStopping;
+
+	/**
+	 * Number of chunks deleted by the background thread
+	 */
+	uint64_t m_numReclaimedChunks;
+
+	/**
+	 * Background thread deleting the chunks
+	 */
+	std::thread m_thread;
+
+public:
+	/**
+	 * @brief Constructor. Starts the background thread.
+	 */
+	ChunkReclaimer();
+
+	/**
+	 * @brief Destructor. Deletes the pending chunks and stops the background thread.
+	 */
+	~ChunkReclaimer();
+
+	/**
+	 * @brief Hands the chunk over to the background thread, which deletes it.
+	 * The chunk should already be removed from the world and its caches.
+	 * @param[in] chunk Chunk to delete
+	 */
+	void Reclaim(Chunk* chunk);
+
+	/**
+	 * @brief Gets the number of chunks waiting to be deleted
+	 * @return Number of pending chunks
+	 */
+	size_t GetPendingCount() const;
+
+	/**
+	 * @brief Gets the number of chunks deleted by the background thread
+	 * @return Number of reclaimed chunks
+	 */
+	uint64_t GetReclaimedCount() const;
+
+private:
+	/**
+	 * @brief Deletes chunks as they are handed over until the reclaimer is stopped
+	 */
+	void Run();
+};
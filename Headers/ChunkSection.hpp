@@ -0,0 +1,212 @@
+#pragma once
+
+#include "BlockStorage.hpp"
+#include "Constants.hpp"
+#include "Enums/BlockTypeEnum.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Vertical slice of a chunk, Constants::SECTION_HEIGHT blocks high.
+ * Chunks only allocate sections that contain at least one non-air block.
+ */
+class ChunkSection
+{
+public:
+	/**
+	 * Number of 64-bit words in an occupancy mask. Each word holds four rows of 16 blocks along the x-axis,
+	 * for z-coordinates (z & ~3) to (z | 3) in a single layer. Word index is (y << 2) | (z >> 2),
+	 * and the bit index is ((z & 3) << 4) | x.
+	 */
+	static const int OCCUPANCY_WORD_COUNT = Constants::SECTION_HEIGHT * Constants::CHUNK_DEPTH * Constants::CHUNK_WIDTH / 64;
+
+private:
+	/**
+	 * Block data
+	 */
+	BlockStorage m_blocks;
+
+	/**
+	 * Number of non-air blocks in this section
+	 */
+	uint32_t m_numNonAirBlocks;
+
+	/**
+	 * Bit mask of the solid blocks in this section
+	 */
+	std::array<uint64_t, OCCUPANCY_WORD_COUNT> m_solidMask;
+
+	/**
+	 * Bit mask of the liquid blocks in this section
+	 */
+	std::array<uint64_t, OCCUPANCY_WORD_COUNT> m_liquidMask;
+
+	/**
+	 * Flag indicating that this section was registered in a SharedSectionTable.
+	 * Registered sections can be handed out to any chunk at any time, so they are never modified again.
+	 */
+	bool m_isShared;
+
+public:
+	/**
+	 * @brief Constructor. The section starts out filled with air.
+	 */
+	ChunkSection();
+
+	/**
+	 * @brief Copy constructor. The copy is not registered anywhere, so it can be modified.
+	 * @param[in] other Section to copy
+	 */
+	ChunkSection(const ChunkSection& other);
+
+	/**
+	 * @brief Destructor
+	 */
+	~ChunkSection();
+
+	/**
+	 * @brief Gets the block at the specified location
+	 * @param[in] x X-coordinate within the section
+	 * @param[in] y Y-coordinate within the section
+	 * @param[in] z Z-coordinate within the section
+	 * @return Type of the block at the specified location
+	 */
+	BlockTypeEnum GetBlockAt(const int& x, const int& y, const int& z) const;
+
+	/**
+	 * @brief Sets the block at the specified location
+	 * @param[in] x X-coordinate within the section
+	 * @param[in] y Y-coordinate within the section
+	 * @param[in] z Z-coordinate within the section
+	 * @param[in] type Type of the new block
+	 */
+	void SetBlockAt(const int& x, const int& y, const int& z, const BlockTypeEnum& type);
+
+	/**
+	 * @brief Resets every block in this section to air, keeping the allocated storage for reuse
+	 */
+	void Clear();
+
+	/**
+	 * @brief Checks whether this section only contains air
+	 * @return True if this section only contains air, false otherwise
+	 */
+	bool IsEmpty() const;
+
+	/**
+	 * @brief Checks whether every block in this section has the same type
+	 * @return True if every block in this section has the same type, false otherwise
+	 */
+	bool IsUniform() const;
+
+	/**
+	 * @brief Gets the number of non-air blocks in this section
+	 * @return Number of non-air blocks
+	 */
+	uint32_t GetNonAirBlockCount() const;
+
+	/**
+	 * @brief Checks whether the block at the specified location is solid
+	 * @param[in] x X-coordinate within the section
+	 * @param[in] y Y-coordinate within the section
+	 * @param[in] z Z-coordinate within the section
+	 * @return True if the block is solid
+	 */
+	bool IsSolidAt(const int& x, const int& y, const int& z) const;
+
+	/**
+	 * @brief Checks whether the block at the specified location is a liquid
+	 * @param[in] x X-coordinate within the section
+	 * @param[in] y Y-coordinate within the section
+	 * @param[in] z Z-coordinate within the section
+	 * @return True if the block is a liquid
+	 */
+	bool IsLiquidAt(const int& x, const int& y, const int& z) const;
+
+	/**
+	 * @brief Gets a word of the solid block mask
+	 * @param[in] wordIndex Word index, which is (y << 2) | (z >> 2)
+	 * @return Solid block bits of four rows along the x-axis
+	 */
+	uint64_t GetSolidMaskWord(const int& wordIndex) const;
+
+	/**
+	 * @brief Gets a word of the liquid block mask
+	 * @param[in] wordIndex Word index, which is (y << 2) | (z >> 2)
+	 * @return Liquid block bits of four rows along the x-axis
+	 */
+	uint64_t GetLiquidMaskWord(const int& wordIndex) const;
+
+	/**
+	 * @brief Compacts the block storage of this section.
+	 * Uniform sections end up storing a single value.
+	 */
+	void Compact();
+
+	/**
+	 * @brief Gets the number of bytes used by this section
+	 * @return Memory usage in bytes
+	 */
+	size_t GetMemoryUsage() const;
+
+	/**
+	 * @brief Appends the block data of this section to the buffer
+	 * @param[out] buffer Buffer to append to
+	 */
+	void Serialize(std::vector<uint8_t>& buffer) const;
+
+	/**
+	 * @brief Replaces the block data of this section with serialized data
+	 * @param[in] data Serialized data
+	 * @param[in] size Number of bytes available in the data
+	 * @return Number of bytes read. Returns 0 if the data is malformed.
+	 */
+	size_t Deserialize(const uint8_t* data, const size_t& size);
+
+	/**
+	 * @brief Appends the run-length encoded block data of this section to the buffer
+	 * @param[out] buffer Buffer to append to
+	 */
+	void EncodeRuns(std::vector<uint8_t>& buffer) const;
+
+	/**
+	 * @brief Replaces the block data of this section with run-length encoded data
+	 * @param[in] data Encoded data
+	 * @param[in] size Number of bytes available in the data
+	 * @return Number of bytes read. Returns 0 if the data is malformed.
+	 */
+	size_t DecodeRuns(const uint8_t* data, const size_t& size);
+
+	/**
+	 * @brief Gets a hash of the block data of this section
+	 * @return Content hash
+	 */
+	uint64_t GetContentHash() const;
+
+	/**
+	 * @brief Checks whether this section stores the same block data as another section
+	 * @param[in] other Section to compare with
+	 * @return True if both sections have the same content
+	 */
+	bool HasSameContent(const ChunkSection& other) const;
+
+	/**
+	 * @brief Marks this section as registered in a SharedSectionTable, which makes it immutable
+	 */
+	void MarkShared();
+
+	/**
+	 * @brief Checks whether this section was registered in a SharedSectionTable
+	 * @return True if this section must not be modified, false otherwise
+	 */
+	bool IsShared() const;
+
+private:
+	/**
+	 * @brief Counts the non-air blocks and rebuilds the occupancy masks after the block data was replaced
+	 */
+	void RecalculateOccupancy();
+};
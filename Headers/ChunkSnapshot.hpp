@@ -0,0 +1,132 @@
+#pragma once
+
+#include "ChunkSection.hpp"
+#include "Constants.hpp"
+#include "Enums/BlockTypeEnum.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+
+/**
+ * Immutable view of a chunk's block data at a specific version.
+ * Shares its sections with the chunk. The chunk copies a shared section before
+ * modifying it, so a snapshot can be read from another thread while the chunk is being edited.
+ */
+class ChunkSnapshot
+{
+public:
+	/**
+	 * Sections of the snapshot. An entry is nullptr if that section only contains air.
+	 */
+	typedef std::array<std::shared_ptr<const ChunkSection>, Constants::CHUNK_SECTION_COUNT> SectionArray;
+
+	/**
+	 * Height of each column, stored row by row along the z-axis
+	 */
+	typedef std::array<uint16_t, Constants::CHUNK_WIDTH * Constants::CHUNK_DEPTH> HeightMap;
+
+private:
+	/**
+	 * Block data, split into vertical sections
+	 */
+	SectionArray m_sections;
+
+	/**
+	 * Height of each column at the time the snapshot was taken
+	 */
+	HeightMap m_heightMap;
+
+	/**
+	 * Lower bound of the y-coordinate of the lowest non-air block
+	 */
+	int m_minHeight;
+
+	/**
+	 * Height of the tallest column
+	 */
+	int m_maxHeight;
+
+	/**
+	 * Chunk indices in each axis of the chunk the snapshot was taken from
+	 */
+	glm::ivec3 m_chunkIndex;
+
+	/**
+	 * Version of the chunk the snapshot was taken from
+	 */
+	uint64_t m_version;
+
+public:
+	/**
+	 * @brief Constructor. Creates an empty snapshot that only contains air.
+	 */
+	ChunkSnapshot();
+
+	/**
+	 * @brief Constructor
+	 * @param[in] chunkIndex Chunk indices in each axis
+	 * @param[in] version Version of the chunk
+	 * @param[in] sections Sections of the chunk
+	 * @param[in] heightMap Height of each column
+	 * @param[in] minHeight Lower bound of the lowest non-air block
+	 * @param[in] maxHeight Height of the tallest column
+	 */
+	ChunkSnapshot(const glm::ivec3& chunkIndex, const uint64_t& version, const SectionArray& sections,
+		const HeightMap& heightMap, const int& minHeight, const int& maxHeight);
+
+	/**
+	 * @brief Destructor
+	 */
+	~ChunkSnapshot();
+
+	/**
+	 * @brief Gets the chunk indices in each axis of the chunk the snapshot was taken from
+	 * @return Chunk indices for each axis
+	 */
+	glm::ivec3 GetChunkIndices() const;
+
+	/**
+	 * @brief Gets the version of the chunk at the time the snapshot was taken
+	 * @return Chunk version
+	 */
+	uint64_t GetVersion() const;
+
+	/**
+	 * @brief Gets the block at the specified location
+	 * @param[in] x X-coordinate
+	 * @param[in] y Y-coordinate
+	 * @param[in] z z-coordinate
+	 * @return Type of the block at the specified location
+	 */
+	BlockTypeEnum GetBlockAt(const int& x, const int& y, const int& z) const;
+
+	/**
+	 * @brief Gets the height of the specified column
+	 * @param[in] x X-coordinate
+	 * @param[in] z Z-coordinate
+	 * @return Height of the column. Returns 0 if the column only contains air.
+	 */
+	int GetHeightAt(const int& x, const int& z) const;
+
+	/**
+	 * @brief Gets a lower bound of the y-coordinate of the lowest non-air block
+	 * @return Lower bound of the lowest non-air block. Returns Constants::CHUNK_HEIGHT if the snapshot is empty.
+	 */
+	int GetMinHeight() const;
+
+	/**
+	 * @brief Gets the height of the tallest column
+	 * @return Height of the tallest column
+	 */
+	int GetMaxHeight() const;
+
+	/**
+	 * @brief Gets the section at the specified section index
+	 * @param[in] sectionIndex Section index
+	 * @return Section at the specified index. Returns nullptr if the section only contains air.
+	 */
+	const ChunkSection* GetSection(const int& sectionIndex) const;
+};
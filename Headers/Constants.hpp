@@ -2,6 +2,7 @@
 
 #include <glm/glm.hpp>
 
+#include <cstddef>
 #include <cstdint>
 
 namespace Constants
@@ -22,15 +23,97 @@ namespace Constants
 	const int CHUNK_WIDTH = 16;
 
 	/**
-	 * Chunk height
+	 * Chunk height. Chunks are cubes stacked on top of each other to make up the height of the world.
 	 */
-	const int CHUNK_HEIGHT = 256;
+	const int CHUNK_HEIGHT = 16;
 
 	/**
 	 * Chunk depth
 	 */
 	const int CHUNK_DEPTH = 16;
 
+	/**
+	 * Height of a chunk section
+	 */
+	const int SECTION_HEIGHT = 16;
+
+	/**
+	 * Number of sections stacked in a chunk
+	 */
+	const int CHUNK_SECTION_COUNT = CHUNK_HEIGHT / SECTION_HEIGHT;
+
+	/**
+	 * Height of the world in blocks
+	 */
+	const int WORLD_HEIGHT = 256;
+
+	/**
+	 * Number of chunks stacked to make up the height of the world
+	 */
+	const int WORLD_HEIGHT_IN_CHUNKS = WORLD_HEIGHT / CHUNK_HEIGHT;
+
+	/**
+	 * Default number of chunks loaded above and below the chunk containing the camera
+	 */
+	const int VERTICAL_LOAD_RADIUS = 2;
+
+	/**
+	 * Seed of the noise the terrain heights are taken from
+	 */
+	const int TERRAIN_NOISE_SEED = 1337;
+
+	/**
+	 * Frequency of the OpenSimplex2 noise, applied on top of the scale of each octave. Same as the default frequency of FastNoiseLite.
+	 */
+	const float NOISE_FREQUENCY = 0.01f;
+
+	/**
+	 * Maximum number of unloaded chunks kept around for reuse
+	 */
+	const size_t MAX_POOLED_CHUNKS = 256;
+
+	/**
+	 * Default number of bytes that chunks outside the loaded area can use before they get evicted
+	 */
+	const size_t CHUNK_CACHE_BUDGET = 64 * 1024 * 1024;
+
+	/**
+	 * Number of chunks along each axis of a region file
+	 */
+	const int REGION_SIZE = 16;
+
+	/**
+	 * Size in bytes of a page in a region file. Chunk data and the offset table are aligned to pages.
+	 */
+	const size_t REGION_PAGE_SIZE = 4096;
+
+	/**
+	 * Maximum number of chunk reads and writes handed to the kernel at once by the io_uring backend
+	 */
+	const unsigned int CHUNK_IO_QUEUE_DEPTH = 256;
+
+	/**
+	 * Number of worker threads used by the thread pool chunk I/O backend
+	 */
+	const size_t NUM_CHUNK_IO_THREADS = 2;
+
+	/**
+	 * Number of times the data of a chunk save is written before the write is reported as failed
+	 */
+	const uint32_t MAX_CHUNK_WRITE_ATTEMPTS = 3;
+
+	/**
+	 * Number of times the saved data of a chunk is read before the chunk is left out until its area is loaded again
+	 */
+	const uint32_t MAX_CHUNK_READ_ATTEMPTS = 3;
+
+	/**
+	 * Number of chunks per job system worker thread that can be generating at once.
+	 * The remaining requested chunks wait in the world so that they can be reordered when the camera moves.
+	 * Roughly the number of chunks a worker generates in a frame, so that the workers do not run out of work between frames.
+	 */
+	const size_t MAX_CHUNK_GENERATIONS_PER_WORKER = 128;
+
 	/**
 	 * Block size
 	 */
@@ -1,13 +1,17 @@
 #pragma once
 
+#include <cstdint>
+
 /**
- * Block type enum
+ * Block type enum. Blocks are stored in chunks as these values.
  */
-enum class BlockTypeEnum
+enum class BlockTypeEnum : uint8_t
 {
 	AIR,
 	WATER,
 	DIRT,
 	STONE,
-	SAND
+	SAND,
+
+	COUNT
 };
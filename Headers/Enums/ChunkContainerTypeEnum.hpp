@@ -0,0 +1,11 @@
+#pragma once
+
+/**
+ * Chunk container type enum
+ */
+enum class ChunkContainerTypeEnum
+{
+	VECTOR,		// Linear search through a list of chunks
+	HASH_MAP,	// Hash map keyed on the packed chunk indices
+	RING_BUFFER	// Fixed-size toroidal grid centered on the loaded area
+};
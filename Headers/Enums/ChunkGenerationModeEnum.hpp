@@ -0,0 +1,10 @@
+#pragma once
+
+/**
+ * Chunk generation mode enum
+ */
+enum class ChunkGenerationModeEnum
+{
+	JOB_SYSTEM,	// Chunks are generated and meshed on the job system worker threads
+	TIME_SLICED	// Chunks are generated and meshed a few blocks at a time on the main thread, within a time budget per frame
+};
@@ -0,0 +1,10 @@
+#pragma once
+
+/**
+ * Chunk I/O backend enum
+ */
+enum class ChunkIOBackendEnum
+{
+	IO_URING,	// Batches submitted to the kernel through an io_uring instance. Only available on Linux.
+	THREAD_POOL	// Blocking reads and writes on a pool of worker threads
+};
@@ -0,0 +1,10 @@
+#pragma once
+
+/**
+ * Chunk I/O operation enum
+ */
+enum class ChunkIOOperationEnum
+{
+	READ,	// Read saved chunk data from a region file
+	WRITE	// Write chunk data to room reserved in a region file
+};
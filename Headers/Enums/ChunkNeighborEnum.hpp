@@ -0,0 +1,15 @@
+#pragma once
+
+/**
+ * Chunk neighbor enum
+ */
+enum class ChunkNeighborEnum
+{
+	POSITIVE_X,	// Neighbor in the +x direction
+	NEGATIVE_X,	// Neighbor in the -x direction
+	POSITIVE_Y,	// Neighbor in the +y direction
+	NEGATIVE_Y,	// Neighbor in the -y direction
+	POSITIVE_Z,	// Neighbor in the +z direction
+	NEGATIVE_Z,	// Neighbor in the -z direction
+	COUNT		// Number of neighbors
+};
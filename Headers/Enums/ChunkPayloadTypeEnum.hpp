@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Type of the data saved for a chunk in a region file.
+ * Stored as the first byte of the chunk data.
+ */
+enum class ChunkPayloadTypeEnum : uint8_t
+{
+	BLOCK_DATA,		// Complete block data of the chunk
+	EDIT_JOURNAL	// Block changes relative to the generated terrain
+};
@@ -0,0 +1,16 @@
+#pragma once
+
+/**
+ * Stage of the lifecycle of a chunk, in the order a chunk normally goes through them
+ */
+enum class ChunkStateEnum
+{
+	REQUESTED,	// Chunk is waiting for its block data to be generated or loaded
+	GENERATING,	// Block data is being generated or loaded
+	GENERATED,	// Block data is ready, but there are no meshes for it
+	MESHING,	// Meshes are being built from the block data
+	UPLOADED,	// Meshes are uploaded, but the chunk is not in the world yet
+	VISIBLE,	// Chunk is in the world and gets drawn
+	UNLOADING,	// Chunk left the loaded area and is waiting to be restored or evicted
+	COUNT		// Number of states
+};
@@ -0,0 +1,10 @@
+#pragma once
+
+/**
+ * Job affinity enum
+ */
+enum class JobAffinityEnum
+{
+	ANY_THREAD,	// Run by whichever worker thread gets to it first
+	MAIN_THREAD	// Run by the main thread, for work that needs the GL context
+};
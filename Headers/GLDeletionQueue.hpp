@@ -0,0 +1,59 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * List of GL objects whose deletion was deferred, so that the objects can be
+ * detached from their owners on any frame and deleted together on the render thread.
+ * The queue itself is not thread-safe and should only be used from the render thread.
+ */
+class GLDeletionQueue
+{
+private:
+	/**
+	 * Buffer handles waiting to be deleted
+	 */
+	std::vector<GLuint> m_buffers;
+
+	/**
+	 * Vertex array handles waiting to be deleted
+	 */
+	std::vector<GLuint> m_vertexArrays;
+
+public:
+	/**
+	 * @brief Constructor
+	 */
+	GLDeletionQueue();
+
+	/**
+	 * @brief Destructor. Deletes the objects that are still in the queue.
+	 */
+	~GLDeletionQueue();
+
+	/**
+	 * @brief Adds the buffer to the queue. Does nothing if the handle is 0.
+	 * @param[in] buffer Buffer handle
+	 */
+	void EnqueueBuffer(const GLuint& buffer);
+
+	/**
+	 * @brief Adds the vertex array to the queue. Does nothing if the handle is 0.
+	 * @param[in] vertexArray Vertex array handle
+	 */
+	void EnqueueVertexArray(const GLuint& vertexArray);
+
+	/**
+	 * @brief Deletes every object in the queue. Should be called on the render thread.
+	 */
+	void Flush();
+
+	/**
+	 * @brief Gets the number of objects waiting to be deleted
+	 * @return Number of queued objects
+	 */
+	size_t GetPendingCount() const;
+};
@@ -0,0 +1,174 @@
+#pragma once
+
+#include "Enums/ChunkIOBackendEnum.hpp"
+#include "IO/ChunkIORequest.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Base class for a backend that reads and writes chunk data without blocking the caller.
+ * Requests are enqueued into a batch, the batch is handed to the backend with Submit(),
+ * and the callbacks of completed requests are invoked by PollCompletions().
+ * Apart from the work done by the backend itself, every function should be called from the same thread.
+ */
+class BaseChunkIO
+{
+protected:
+	/**
+	 * Number of requests that were enqueued and whose callbacks have not been invoked yet
+	 */
+	size_t m_numPendingRequests;
+
+	/**
+	 * Number of reads that completed successfully
+	 */
+	uint64_t m_numReads;
+
+	/**
+	 * Number of writes that completed successfully
+	 */
+	uint64_t m_numWrites;
+
+	/**
+	 * Number of bytes read by successful reads
+	 */
+	uint64_t m_numBytesRead;
+
+	/**
+	 * Number of bytes written by successful writes
+	 */
+	uint64_t m_numBytesWritten;
+
+	/**
+	 * Number of requests that failed
+	 */
+	uint64_t m_numFailures;
+
+public:
+	/**
+	 * @brief Constructor
+	 */
+	BaseChunkIO()
+		: m_numPendingRequests(0)
+		, m_numReads(0)
+		, m_numWrites(0)
+		, m_numBytesRead(0)
+		, m_numBytesWritten(0)
+		, m_numFailures(0)
+	{
+	}
+
+	/**
+	 * @brief Destructor
+	 */
+	virtual ~BaseChunkIO()
+	{
+	}
+
+	/**
+	 * @brief Gets the type of this backend
+	 * @return Backend type
+	 */
+	virtual ChunkIOBackendEnum GetBackendType() const = 0;
+
+	/**
+	 * @brief Adds the request to the batch that is handed to the backend on the next call to Submit()
+	 * @param[in] request Request to add. The backend takes ownership of the request.
+	 */
+	virtual void Enqueue(ChunkIORequest* request) = 0;
+
+	/**
+	 * @brief Hands every enqueued request to the backend
+	 */
+	virtual void Submit() = 0;
+
+	/**
+	 * @brief Invokes the callbacks of the requests that completed since the last call, then deletes the requests
+	 */
+	virtual void PollCompletions() = 0;
+
+	/**
+	 * @brief Submits the enqueued requests and blocks until every request has completed.
+	 * The callbacks are not invoked until the next call to PollCompletions().
+	 */
+	virtual void WaitForAll() = 0;
+
+	/**
+	 * @brief Gets the number of requests that were enqueued and whose callbacks have not been invoked yet
+	 * @return Number of pending requests
+	 */
+	size_t GetPendingCount() const
+	{
+		return m_numPendingRequests;
+	}
+
+	/**
+	 * @brief Gets the number of reads that completed successfully
+	 * @return Number of reads
+	 */
+	uint64_t GetReadCount() const
+	{
+		return m_numReads;
+	}
+
+	/**
+	 * @brief Gets the number of writes that completed successfully
+	 * @return Number of writes
+	 */
+	uint64_t GetWriteCount() const
+	{
+		return m_numWrites;
+	}
+
+	/**
+	 * @brief Gets the number of bytes read by successful reads
+	 * @return Number of bytes read
+	 */
+	uint64_t GetBytesRead() const
+	{
+		return m_numBytesRead;
+	}
+
+	/**
+	 * @brief Gets the number of bytes written by successful writes
+	 * @return Number of bytes written
+	 */
+	uint64_t GetBytesWritten() const
+	{
+		return m_numBytesWritten;
+	}
+
+	/**
+	 * @brief Gets the number of requests that failed
+	 * @return Number of failed requests
+	 */
+	uint64_t GetFailureCount() const
+	{
+		return m_numFailures;
+	}
+
+protected:
+	/**
+	 * @brief Updates the statistics with a request whose callback is about to be invoked
+	 * @param[in] request Completed request
+	 */
+	void RecordCompletion(const ChunkIORequest& request)
+	{
+		--m_numPendingRequests;
+		if (!request.succeeded)
+		{
+			++m_numFailures;
+		}
+		else if (request.operation == ChunkIOOperationEnum::READ)
+		{
+			++m_numReads;
+			m_numBytesRead += request.data->size();
+		}
+		else
+		{
+			++m_numWrites;
+			m_numBytesWritten += request.data->size();
+		}
+	}
+};
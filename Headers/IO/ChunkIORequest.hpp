@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Enums/ChunkIOOperationEnum.hpp"
+#include "RegionFile.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * Read or write of chunk data at an offset in a region file, performed asynchronously by a chunk I/O backend
+ */
+struct ChunkIORequest
+{
+	/**
+	 * Whether the data is read or written
+	 */
+	ChunkIOOperationEnum operation;
+
+	/**
+	 * Region file to read from or write to. Has to stay open until the request completes.
+	 */
+	RegionFile* regionFile;
+
+	/**
+	 * Offset from the start of the region file in bytes
+	 */
+	uint64_t offset;
+
+	/**
+	 * Bytes to write, or buffer receiving the bytes read. Its size is the number of bytes to transfer.
+	 */
+	std::shared_ptr<std::vector<uint8_t>> data;
+
+	/**
+	 * Flag indicating that every byte was transferred. Set by the backend when the request completes.
+	 */
+	bool succeeded;
+
+	/**
+	 * Called with the completed request on the thread that polls the backend for completions
+	 */
+	std::function<void(ChunkIORequest&)> callback;
+};
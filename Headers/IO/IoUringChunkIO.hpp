@@ -0,0 +1,183 @@
+#pragma once
+
+#ifdef __linux__
+
+#include "IO/BaseChunkIO.hpp"
+
+#include <cstddef>
+#include <vector>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+/**
+ * Chunk I/O backend that hands each batch of requests to the kernel with a single system call
+ * through an io_uring instance, and collects the completions from its completion queue.
+ * Only available on Linux 5.6 or newer. Check IsInitialized() after constructing it.
+ */
+class IoUringChunkIO : public BaseChunkIO
+{
+private:
+	/**
+	 * Descriptor of the io_uring instance. -1 if the instance could not be created.
+	 */
+	int m_ringFileDescriptor;
+
+	/**
+	 * Maximum number of requests in flight at once. Also the size of the submission queue.
+	 */
+	unsigned int m_queueDepth;
+
+	/**
+	 * Start of the mapped submission queue ring
+	 */
+	void* m_submissionRing;
+
+	/**
+	 * Number of bytes mapped for the submission queue ring
+	 */
+	size_t m_submissionRingSize;
+
+	/**
+	 * Start of the mapped completion queue ring. Same as the submission ring if the kernel maps both at once.
+	 */
+	void* m_completionRing;
+
+	/**
+	 * Number of bytes mapped for the completion queue ring
+	 */
+	size_t m_completionRingSize;
+
+	/**
+	 * Mapped submission queue entries
+	 */
+	io_uring_sqe* m_submissionEntries;
+
+	/**
+	 * Number of submission queue entries
+	 */
+	unsigned int m_numSubmissionEntries;
+
+	/**
+	 * Head of the submission queue, advanced by the kernel
+	 */
+	unsigned int* m_submissionHead;
+
+	/**
+	 * Tail of the submission queue, advanced by this backend
+	 */
+	unsigned int* m_submissionTail;
+
+	/**
+	 * Mask applied to submission queue positions to get ring indices
+	 */
+	unsigned int m_submissionMask;
+
+	/**
+	 * Indices of the submission queue entries to submit, in order
+	 */
+	unsigned int* m_submissionArray;
+
+	/**
+	 * Head of the completion queue, advanced by this backend
+	 */
+	unsigned int* m_completionHead;
+
+	/**
+	 * Tail of the completion queue, advanced by the kernel
+	 */
+	unsigned int* m_completionTail;
+
+	/**
+	 * Mask applied to completion queue positions to get ring indices
+	 */
+	unsigned int m_completionMask;
+
+	/**
+	 * Completion queue entries
+	 */
+	io_uring_cqe* m_completionEntries;
+
+	/**
+	 * Requests enqueued since the last call to Submit()
+	 */
+	std::vector<ChunkIORequest*> m_batch;
+
+	/**
+	 * Requests taken from the completion queue whose callbacks have not been invoked yet
+	 */
+	std::vector<ChunkIORequest*> m_completedRequests;
+
+	/**
+	 * Number of requests placed in the submission queue that have not been taken from the completion queue yet
+	 */
+	size_t m_numInFlight;
+
+public:
+	/**
+	 * @brief Constructor. Creates the io_uring instance.
+	 * @param[in] queueDepth Maximum number of requests in flight at once
+	 */
+	IoUringChunkIO(const unsigned int& queueDepth);
+
+	/**
+	 * @brief Destructor. Waits for the submitted requests, then destroys the io_uring instance.
+	 * Callbacks of requests that were not polled yet are not invoked.
+	 */
+	~IoUringChunkIO();
+
+	/**
+	 * @brief Checks whether the io_uring instance was created. The backend cannot be used otherwise.
+	 * @return True if the io_uring instance is ready
+	 */
+	bool IsInitialized() const;
+
+	/**
+	 * @brief Gets the type of this backend
+	 * @return Backend type
+	 */
+	ChunkIOBackendEnum GetBackendType() const override;
+
+	/**
+	 * @brief Adds the request to the batch that is handed to the backend on the next call to Submit()
+	 * @param[in] request Request to add. The backend takes ownership of the request.
+	 */
+	void Enqueue(ChunkIORequest* request) override;
+
+	/**
+	 * @brief Places the enqueued requests in the submission queue and submits them to the kernel.
+	 * Waits for completions whenever the queue depth is reached.
+	 */
+	void Submit() override;
+
+	/**
+	 * @brief Invokes the callbacks of the requests that completed since the last call, then deletes the requests
+	 */
+	void PollCompletions() override;
+
+	/**
+	 * @brief Submits the enqueued requests and blocks until every request has completed.
+	 * The callbacks are not invoked until the next call to PollCompletions().
+	 */
+	void WaitForAll() override;
+
+private:
+	/**
+	 * @brief Submits the entries placed in the submission queue, optionally waiting for completions
+	 * @param[in] minCompletions Number of completions to wait for
+	 * @return True if the kernel accepted the call
+	 */
+	bool Enter(const unsigned int& minCompletions);
+
+	/**
+	 * @brief Takes the available entries from the completion queue and moves their requests to the completed requests
+	 */
+	void ReapCompletions();
+
+	/**
+	 * @brief Releases the mapped rings and closes the io_uring instance
+	 */
+	void Destroy();
+};
+
+#endif
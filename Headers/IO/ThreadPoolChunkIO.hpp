@@ -0,0 +1,110 @@
+#pragma once
+
+#include "IO/BaseChunkIO.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Chunk I/O backend that performs blocking reads and writes on a pool of worker threads.
+ * Works on every platform.
+ */
+class ThreadPoolChunkIO : public BaseChunkIO
+{
+private:
+	/**
+	 * Requests enqueued since the last call to Submit()
+	 */
+	std::vector<ChunkIORequest*> m_batch;
+
+	/**
+	 * Submitted requests waiting for a worker thread
+	 */
+	std::deque<ChunkIORequest*> m_queuedRequests;
+
+	/**
+	 * Requests whose callbacks have to be invoked by the next call to PollCompletions()
+	 */
+	std::vector<ChunkIORequest*> m_completedRequests;
+
+	/**
+	 * Number of submitted requests that have not completed yet
+	 */
+	size_t m_numInFlight;
+
+	/**
+	 * Flag indicating that the worker threads should finish the queued requests and exit
+	 */
+	bool m_isStopping;
+
+	/**
+	 * Mutex guarding the queued and completed requests, the in-flight count and the stop flag
+	 */
+	std::mutex m_mutex;
+
+	/**
+	 * Signalled when requests are submitted or the backend is stopped
+	 */
+	std::condition_variable m_workAvailable;
+
+	/**
+	 * Signalled when the last in-flight request completes
+	 */
+	std::condition_variable m_allCompleted;
+
+	/**
+	 * Worker threads performing the requests
+	 */
+	std::vector<std::thread> m_threads;
+
+public:
+	/**
+	 * @brief Constructor. Starts the worker threads.
+	 * @param[in] numThreads Number of worker threads
+	 */
+	ThreadPoolChunkIO(const size_t& numThreads);
+
+	/**
+	 * @brief Destructor. Waits for the submitted requests, then stops the worker threads.
+	 * Callbacks of requests that were not polled yet are not invoked.
+	 */
+	~ThreadPoolChunkIO();
+
+	/**
+	 * @brief Gets the type of this backend
+	 * @return Backend type
+	 */
+	ChunkIOBackendEnum GetBackendType() const override;
+
+	/**
+	 * @brief Adds the request to the batch that is handed to the backend on the next call to Submit()
+	 * @param[in] request Request to add. The backend takes ownership of the request.
+	 */
+	void Enqueue(ChunkIORequest* request) override;
+
+	/**
+	 * @brief Hands every enqueued request to the worker threads
+	 */
+	void Submit() override;
+
+	/**
+	 * @brief Invokes the callbacks of the requests that completed since the last call, then deletes the requests
+	 */
+	void PollCompletions() override;
+
+	/**
+	 * @brief Submits the enqueued requests and blocks until every request has completed.
+	 * The callbacks are not invoked until the next call to PollCompletions().
+	 */
+	void WaitForAll() override;
+
+private:
+	/**
+	 * @brief Performs queued requests until the backend is stopped
+	 */
+	void Run();
+};
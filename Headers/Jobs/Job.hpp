@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Enums/JobAffinityEnum.hpp"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class JobSystem;
+
+/**
+ * Unit of work run by the job system once every job it depends on has completed
+ */
+class Job : public std::enable_shared_from_this<Job>
+{
+	friend class JobSystem;
+
+private:
+	/**
+	 * Work done by the job. Released once it has run.
+	 */
+	std::function<void()> m_function;
+
+	/**
+	 * Thread the job has to run on
+	 */
+	JobAffinityEnum m_affinity;
+
+	/**
+	 * Number of dependencies that have not completed yet, plus one until the job is submitted
+	 */
+	std::atomic<int> m_numPendingDependencies;
+
+	/**
+	 * Jobs waiting for this job to complete
+	 */
+	std::vector<std::shared_ptr<Job>> m_dependents;
+
+	/**
+	 * Flag indicating that the job has run
+	 */
+	std::atomic<bool> m_isCompleted;
+
+	/**
+	 * Mutex guarding the dependents, so that a job cannot be added as a dependent after this job completed
+	 */
+	std::mutex m_mutex;
+
+public:
+	/**
+	 * @brief Constructor
+	 * @param[in] function Work done by the job
+	 * @param[in] affinity Thread the job has to run on
+	 */
+	Job(const std::function<void()>& function, const JobAffinityEnum& affinity = JobAffinityEnum::ANY_THREAD);
+
+	/**
+	 * @brief Destructor
+	 */
+	~Job();
+
+	/**
+	 * @brief Makes this job wait until the provided job has completed.
+	 * Should be called before this job is submitted. The dependency has to be submitted as well, or this job never runs.
+	 * @param[in] dependency Job that has to complete first
+	 */
+	void DependOn(const std::shared_ptr<Job>& dependency);
+
+	/**
+	 * @brief Gets the thread the job has to run on
+	 * @return Job affinity
+	 */
+	JobAffinityEnum GetAffinity() const;
+
+	/**
+	 * @brief Checks whether the job has run
+	 * @return True if the job has completed
+	 */
+	bool IsCompleted() const;
+};
@@ -0,0 +1,189 @@
+#pragma once
+
+#include "Jobs/Job.hpp"
+#include "Jobs/WorkStealingQueue.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Work-stealing scheduler shared by every subsystem that runs work in the background.
+ * Each worker thread owns a queue of ready jobs and steals from the other queues once its own is empty.
+ * Jobs that need the GL context go to a separate queue that the main thread runs with RunMainThreadJobs().
+ * Submitting, waiting and running main thread jobs should be done from the main thread,
+ * except that jobs can submit further jobs from the worker threads.
+ */
+class JobSystem
+{
+private:
+	/**
+	 * Queues of ready jobs, one per worker thread
+	 */
+	std::vector<WorkStealingQueue*> m_workerQueues;
+
+	/**
+	 * Ready jobs that have to run on the main thread
+	 */
+	WorkStealingQueue m_mainThreadQueue;
+
+	/**
+	 * Ready jobs submitted from outside the worker threads. Workers take the oldest job first,
+	 * so these jobs start in the order they were submitted.
+	 */
+	WorkStealingQueue m_submittedQueue;
+
+	/**
+	 * Number of jobs in the worker queues and the queue of submitted jobs
+	 */
+	std::atomic<size_t> m_numQueuedJobs;
+
+	/**
+	 * Number of submitted jobs that have not completed yet
+	 */
+	size_t m_numUnfinishedJobs;
+
+	/**
+	 * Flag indicating that the worker threads should finish the queued jobs and exit
+	 */
+	bool m_isStopping;
+
+	/**
+	 * Number of jobs that have run
+	 */
+	std::atomic<uint64_t> m_numExecutedJobs;
+
+	/**
+	 * Number of jobs that a worker thread took from the queue of another worker thread
+	 */
+	std::atomic<uint64_t> m_numStolenJobs;
+
+	/**
+	 * Time the worker threads spent waiting for work, in microseconds
+	 */
+	std::atomic<uint64_t> m_totalIdleTime;
+
+	/**
+	 * Mutex guarding the unfinished job count and the stop flag, and used to put idle worker threads to sleep
+	 */
+	mutable std::mutex m_mutex;
+
+	/**
+	 * Signalled when jobs are added to the worker queues or the job system is stopped
+	 */
+	std::condition_variable m_workAvailable;
+
+	/**
+	 * Signalled when a job is added to the main thread queue or the last unfinished job completes
+	 */
+	std::condition_variable m_allCompleted;
+
+	/**
+	 * Worker threads running the jobs
+	 */
+	std::vector<std::thread> m_threads;
+
+public:
+	/**
+	 * @brief Constructor. Starts the worker threads.
+	 * @param[in] numThreads Number of worker threads. If 0, no thread is started and every job runs on the main thread.
+	 */
+	JobSystem(const size_t& numThreads);
+
+	/**
+	 * @brief Destructor. Waits for the submitted jobs, then stops the worker threads.
+	 */
+	~JobSystem();
+
+	/**
+	 * @brief Hands the job over to the job system. It runs once every job it depends on has completed.
+	 * @param[in] job Job to run
+	 */
+	void Submit(const std::shared_ptr<Job>& job);
+
+	/**
+	 * @brief Runs the ready jobs that have to run on the main thread, oldest first,
+	 * including the ones that become ready while running them
+	 * @return Number of jobs that were run
+	 */
+	size_t RunMainThreadJobs();
+
+	/**
+	 * @brief Blocks until every submitted job has completed, running the main thread jobs as they become ready
+	 */
+	void WaitForAll();
+
+	/**
+	 * @brief Gets the number of worker threads
+	 * @return Number of worker threads
+	 */
+	size_t GetWorkerCount() const;
+
+	/**
+	 * @brief Gets the number of submitted jobs that have not completed yet, including jobs waiting for their dependencies
+	 * @return Number of unfinished jobs
+	 */
+	size_t GetUnfinishedJobCount() const;
+
+	/**
+	 * @brief Gets the number of ready jobs waiting for a worker thread
+	 * @return Combined depth of the worker queues and the queue of submitted jobs
+	 */
+	size_t GetQueuedJobCount() const;
+
+	/**
+	 * @brief Gets the number of ready jobs waiting for the main thread
+	 * @return Depth of the main thread queue
+	 */
+	size_t GetMainThreadQueuedJobCount() const;
+
+	/**
+	 * @brief Gets the number of jobs that have run
+	 * @return Number of executed jobs
+	 */
+	uint64_t GetExecutedJobCount() const;
+
+	/**
+	 * @brief Gets the number of jobs that a worker thread took from the queue of another worker thread
+	 * @return Number of steals
+	 */
+	uint64_t GetStealCount() const;
+
+	/**
+	 * @brief Gets the time the worker threads spent waiting for work, added up over every worker thread
+	 * @return Idle time in seconds
+	 */
+	float GetIdleTime() const;
+
+private:
+	/**
+	 * @brief Adds a job whose dependencies have completed to the queue it runs from
+	 * @param[in] job Ready job
+	 */
+	void Schedule(const std::shared_ptr<Job>& job);
+
+	/**
+	 * @brief Takes a ready job from the queue of the worker thread, then from the submitted jobs, or steals one from another worker thread
+	 * @param[in] workerIndex Index of the worker thread
+	 * @param[out] job Taken job
+	 * @return True if a job was taken
+	 */
+	bool TakeJob(const size_t& workerIndex, std::shared_ptr<Job>& job);
+
+	/**
+	 * @brief Runs the job, then schedules the dependents whose last dependency it was
+	 * @param[in] job Job to run
+	 */
+	void Execute(const std::shared_ptr<Job>& job);
+
+	/**
+	 * @brief Runs jobs until the job system is stopped
+	 * @param[in] workerIndex Index of the worker thread
+	 */
+	void Run(const size_t& workerIndex);
+};
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Jobs/Job.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+/**
+ * Queue of ready jobs owned by one worker thread. The owner pushes and pops at the back,
+ * so it keeps working on the jobs it made ready most recently while their data is still in its cache.
+ * Other threads steal from the front, taking the oldest jobs.
+ */
+class WorkStealingQueue
+{
+private:
+	/**
+	 * Ready jobs, from the oldest to the newest
+	 */
+	std::deque<std::shared_ptr<Job>> m_jobs;
+
+	/**
+	 * Number of jobs in the queue, readable without taking the lock
+	 */
+	std::atomic<size_t> m_size;
+
+	/**
+	 * Mutex guarding the jobs
+	 */
+	std::mutex m_mutex;
+
+public:
+	/**
+	 * @brief Constructor
+	 */
+	WorkStealingQueue();
+
+	/**
+	 * @brief Destructor
+	 */
+	~WorkStealingQueue();
+
+	/**
+	 * @brief Adds the job at the back of the queue
+	 * @param[in] job Ready job
+	 */
+	void Push(const std::shared_ptr<Job>& job);
+
+	/**
+	 * @brief Takes the newest job from the back of the queue. Used by the owner of the queue.
+	 * @param[out] job Taken job
+	 * @return True if a job was taken, false if the queue is empty
+	 */
+	bool Pop(std::shared_ptr<Job>& job);
+
+	/**
+	 * @brief Takes the oldest job from the front of the queue. Used by threads other than the owner.
+	 * @param[out] job Taken job
+	 * @return True if a job was taken, false if the queue is empty
+	 */
+	bool Steal(std::shared_ptr<Job>& job);
+
+	/**
+	 * @brief Gets the number of jobs in the queue. The value may be outdated by the time it is used.
+	 * @return Number of queued jobs
+	 */
+	size_t GetSize() const;
+};
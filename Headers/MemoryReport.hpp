@@ -0,0 +1,113 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * Number of bytes used, broken down per subsystem
+ */
+struct MemoryUsage
+{
+	/**
+	 * Block data, including palettes, packed indices and compressed block data
+	 */
+	size_t blockStorageBytes;
+
+	/**
+	 * CPU-side vertex and index lists of meshes
+	 */
+	size_t cpuMeshBytes;
+
+	/**
+	 * GPU vertex and index buffers
+	 */
+	size_t gpuBufferBytes;
+
+	/**
+	 * Everything else, such as object headers, height maps, edit journals and lookup tables
+	 */
+	size_t bookkeepingBytes;
+
+	/**
+	 * @brief Constructor. Every count starts at zero.
+	 */
+	MemoryUsage();
+
+	/**
+	 * @brief Gets the total number of bytes across every subsystem
+	 * @return Total bytes
+	 */
+	size_t GetTotal() const;
+
+	/**
+	 * @brief Adds the counts of another breakdown to this one
+	 * @param[in] other Breakdown to add
+	 * @return This breakdown
+	 */
+	MemoryUsage& operator+=(const MemoryUsage& other);
+};
+
+/**
+ * Memory usage of a single chunk
+ */
+struct ChunkMemoryReport
+{
+	/**
+	 * Chunk indices in each axis
+	 */
+	glm::ivec3 chunkIndex;
+
+	/**
+	 * Whether the chunk is in the chunk cache instead of being loaded
+	 */
+	bool isCached;
+
+	/**
+	 * Memory usage of the chunk
+	 */
+	MemoryUsage usage;
+};
+
+/**
+ * Memory usage of the world, per chunk and aggregated
+ */
+struct WorldMemoryReport
+{
+	/**
+	 * Memory usage of every loaded and cached chunk
+	 */
+	std::vector<ChunkMemoryReport> chunks;
+
+	/**
+	 * Combined memory usage of the loaded chunks
+	 */
+	MemoryUsage loadedChunks;
+
+	/**
+	 * Combined memory usage of the chunks in the chunk cache
+	 */
+	MemoryUsage cachedChunks;
+
+	/**
+	 * Combined memory usage of the chunks in the chunk pool
+	 */
+	MemoryUsage pooledChunks;
+
+	/**
+	 * Memory used by the world itself, such as the chunk list and chunk lookup structures
+	 */
+	MemoryUsage world;
+
+	/**
+	 * Sum of every category above
+	 */
+	MemoryUsage total;
+
+	/**
+	 * Number of bytes of region files mapped into the address space. These pages are backed by the files
+	 * and are not counted in the total.
+	 */
+	size_t mappedRegionFileBytes;
+};
@@ -5,6 +5,7 @@
 
 #include <vector>
 
+#include "GLDeletionQueue.hpp"
 #include "ShaderProgram.hpp"
 #include "Vertex.hpp"
 
@@ -38,6 +39,16 @@ struct Mesh
 	 */
 	std::vector<GLuint> indices;
 
+	/**
+	 * Size in bytes of the storage allocated for the VBO
+	 */
+	size_t vertexBufferSize;
+
+	/**
+	 * Size in bytes of the storage allocated for the EBO
+	 */
+	size_t indexBufferSize;
+
 public:
 	/**
 	 * @brief Constructor
@@ -49,6 +60,43 @@ public:
 	 */
 	~Mesh();
 
+	/**
+	 * @brief Uploads the vertex and index lists to the GPU.
+	 * Existing buffers are reused if they are large enough.
+	 */
+	void Upload();
+
+	/**
+	 * @brief Deletes the GPU buffers and frees the vertex and index lists.
+	 * The mesh can be filled and uploaded again afterwards.
+	 */
+	void Release();
+
+	/**
+	 * @brief Hands the GPU buffers over to the deletion queue instead of deleting them right away.
+	 * The vertex and index lists are kept, so the mesh can be destroyed on any thread afterwards.
+	 * @param[in] deletionQueue Queue that deletes the buffers on the render thread
+	 */
+	void DeferBufferDeletion(GLDeletionQueue& deletionQueue);
+
+	/**
+	 * @brief Checks whether the mesh has been uploaded to the GPU
+	 * @return True if the mesh has GPU buffers
+	 */
+	bool IsUploaded() const;
+
+	/**
+	 * @brief Gets the number of bytes allocated for the vertex and index lists
+	 * @return CPU memory usage in bytes
+	 */
+	size_t GetCPUMemoryUsage() const;
+
+	/**
+	 * @brief Gets the number of bytes allocated for the GPU buffers
+	 * @return GPU memory usage in bytes
+	 */
+	size_t GetGPUMemoryUsage() const;
+
 	/**
 	 * @brief Draws the mesh
 	 */
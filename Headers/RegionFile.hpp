@@ -0,0 +1,246 @@
+#pragma once
+
+#include "Constants.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * File holding the saved block data of a cube of
+ * Constants::REGION_SIZE x Constants::REGION_SIZE x Constants::REGION_SIZE chunks.
+ *
+ * The file is memory-mapped, and chunk data can also be read and written at explicit offsets
+ * from other threads. It starts with a header page, followed by a page-aligned
+ * offset table with one entry per chunk, followed by the chunk data.
+ * Each chunk occupies a run of whole pages.
+ */
+class RegionFile
+{
+private:
+	/**
+	 * Entry of the offset table
+	 */
+	struct ChunkEntry
+	{
+		/**
+		 * Index of the first page of the chunk data. A value of 0 means the chunk is not saved.
+		 */
+		uint32_t firstPage;
+
+		/**
+		 * Size of the chunk data in bytes
+		 */
+		uint32_t size;
+	};
+
+	/**
+	 * Header at the start of the file
+	 */
+	struct Header
+	{
+		/**
+		 * File signature
+		 */
+		char magic[4];
+
+		/**
+		 * Version of the file format
+		 */
+		uint32_t formatVersion;
+
+		/**
+		 * Number of pages in use. New chunk data is written after these pages.
+		 */
+		uint32_t numUsedPages;
+	};
+
+	/**
+	 * Number of entries in the offset table
+	 */
+	static const int NUM_CHUNK_ENTRIES = Constants::REGION_SIZE * Constants::REGION_SIZE * Constants::REGION_SIZE;
+
+	/**
+	 * Index of the first page of the offset table
+	 */
+	static const uint32_t OFFSET_TABLE_FIRST_PAGE = 1;
+
+	/**
+	 * Index of the first page that can hold chunk data
+	 */
+	static const uint32_t FIRST_DATA_PAGE = OFFSET_TABLE_FIRST_PAGE
+		+ static_cast<uint32_t>((NUM_CHUNK_ENTRIES * sizeof(ChunkEntry) + Constants::REGION_PAGE_SIZE - 1) / Constants::REGION_PAGE_SIZE);
+
+	/**
+	 * Path to the file
+	 */
+	std::string m_filePath;
+
+#ifdef _WIN32
+	/**
+	 * Handle of the opened file
+	 */
+	void* m_fileHandle;
+
+	/**
+	 * Handle of the file mapping
+	 */
+	void* m_mappingHandle;
+#else
+	/**
+	 * Descriptor of the opened file
+	 */
+	int m_fileDescriptor;
+#endif
+
+	/**
+	 * Start of the mapped file. nullptr if the file is not open.
+	 */
+	uint8_t* m_mappedData;
+
+	/**
+	 * Number of bytes mapped, which is the size of the file
+	 */
+	size_t m_mappedSize;
+
+public:
+	/**
+	 * @brief Constructor
+	 */
+	RegionFile();
+
+	/**
+	 * @brief Destructor
+	 */
+	~RegionFile();
+
+	/**
+	 * @brief Opens the region file, creating it if it does not exist yet
+	 * @param[in] filePath Path to the file
+	 * @return True if the file was opened, false if it could not be opened or is not a valid region file
+	 */
+	bool Open(const std::string& filePath);
+
+	/**
+	 * @brief Flushes and closes the region file
+	 */
+	void Close();
+
+	/**
+	 * @brief Checks whether the region file is open
+	 * @return True if the region file is open
+	 */
+	bool IsOpen() const;
+
+	/**
+	 * @brief Gets a read-only view of the saved data of a chunk in the region.
+	 * The view stays valid until the next call to WriteChunk(), ReserveChunk() or Close().
+	 * @param[in] localX Chunk x-index within the region
+	 * @param[in] localY Chunk y-index within the region
+	 * @param[in] localZ Chunk z-index within the region
+	 * @param[out] data Start of the chunk data
+	 * @param[out] size Size of the chunk data in bytes
+	 * @return True if the chunk is saved in this region file
+	 */
+	bool ReadChunk(const int& localX, const int& localY, const int& localZ, const uint8_t*& data, size_t& size) const;
+
+	/**
+	 * @brief Saves the data of a chunk in the region, replacing any data previously saved for it
+	 * @param[in] localX Chunk x-index within the region
+	 * @param[in] localY Chunk y-index within the region
+	 * @param[in] localZ Chunk z-index within the region
+	 * @param[in] data Chunk data
+	 * @param[in] size Size of the chunk data in bytes
+	 * @return True if the data was written
+	 */
+	bool WriteChunk(const int& localX, const int& localY, const int& localZ, const uint8_t* data, const size_t& size);
+
+	/**
+	 * @brief Gets where the saved data of a chunk is stored in the file, so that it can be read without going through the mapping
+	 * @param[in] localX Chunk x-index within the region
+	 * @param[in] localY Chunk y-index within the region
+	 * @param[in] localZ Chunk z-index within the region
+	 * @param[out] offset Offset of the chunk data from the start of the file in bytes
+	 * @param[out] size Size of the chunk data in bytes
+	 * @return True if the chunk is saved in this region file
+	 */
+	bool LocateChunk(const int& localX, const int& localY, const int& localZ, uint64_t& offset, size_t& size) const;
+
+	/**
+	 * @brief Allocates room for the data of a chunk and points its offset table entry at it, replacing any data previously saved for it.
+	 * The caller has to write the data at the returned offset, for example with WriteAt(). Until then the entry points at stale data.
+	 * @param[in] localX Chunk x-index within the region
+	 * @param[in] localY Chunk y-index within the region
+	 * @param[in] localZ Chunk z-index within the region
+	 * @param[in] size Size of the chunk data in bytes
+	 * @param[out] offset Offset from the start of the file where the chunk data should be written
+	 * @return True if room was allocated
+	 */
+	bool ReserveChunk(const int& localX, const int& localY, const int& localZ, const size_t& size, uint64_t& offset);
+
+	/**
+	 * @brief Reads bytes from the file without going through the mapping. Can be called from any thread.
+	 * @param[in] offset Offset from the start of the file in bytes
+	 * @param[out] buffer Buffer receiving the bytes
+	 * @param[in] size Number of bytes to read
+	 * @return True if every byte was read
+	 */
+	bool ReadAt(const uint64_t& offset, uint8_t* buffer, const size_t& size) const;
+
+	/**
+	 * @brief Writes bytes to the file without going through the mapping. Can be called from any thread.
+	 * The bytes should be within the room allocated by ReserveChunk().
+	 * @param[in] offset Offset from the start of the file in bytes
+	 * @param[in] data Bytes to write
+	 * @param[in] size Number of bytes to write
+	 * @return True if every byte was written
+	 */
+	bool WriteAt(const uint64_t& offset, const uint8_t* data, const size_t& size) const;
+
+#ifndef _WIN32
+	/**
+	 * @brief Gets the descriptor of the opened file, used to submit reads and writes to the kernel directly
+	 * @return File descriptor. Returns -1 if the file is not open.
+	 */
+	int GetFileDescriptor() const;
+#endif
+
+	/**
+	 * @brief Writes modified pages back to the file
+	 */
+	void Flush();
+
+	/**
+	 * @brief Gets the number of bytes of the file mapped into memory
+	 * @return Mapped size in bytes
+	 */
+	size_t GetMappedSize() const;
+
+private:
+	/**
+	 * @brief Gets the header of the mapped file
+	 * @return Header
+	 */
+	Header* GetHeader() const;
+
+	/**
+	 * @brief Gets the offset table entry of a chunk
+	 * @param[in] localX Chunk x-index within the region
+	 * @param[in] localY Chunk y-index within the region
+	 * @param[in] localZ Chunk z-index within the region
+	 * @return Offset table entry
+	 */
+	ChunkEntry* GetChunkEntry(const int& localX, const int& localY, const int& localZ) const;
+
+	/**
+	 * @brief Resizes the file and maps it again
+	 * @param[in] newSize New file size in bytes
+	 * @return True if the file was resized and mapped
+	 */
+	bool Remap(const size_t& newSize);
+
+	/**
+	 * @brief Releases the mapping of the file, keeping the file open
+	 */
+	void Unmap();
+};
@@ -38,6 +38,11 @@ private:
 	 */
 	int m_chunkRenderDistance;
 
+	/**
+	 * Milliseconds per frame spent generating chunks on the main thread when the world generates them time-sliced
+	 */
+	float m_chunkGenerationTimeBudget;
+
 	/**
 	 * Current time
 	 */
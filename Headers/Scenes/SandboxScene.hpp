@@ -103,4 +103,10 @@ private:
      * @brief Updates the image that visualizes the noise map
      */
     void UpdateNoiseImage();
+
+    /**
+     * @brief Measures the throughput of the scalar and the batched noise over the noise image,
+     * and checks that both give the same values
+     */
+    void BenchmarkNoise();
 };
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "ChunkSection.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+/**
+ * Table of chunk sections keyed by a hash of their block data, used to make chunks
+ * with identical sections share a single copy. Registered sections are marked as shared and never modified in place,
+ * since chunks copy a shared section before writing to it, even when they are its only user.
+ * The table only holds weak references, so a section is freed once no chunk uses it.
+ */
+class SharedSectionTable
+{
+private:
+	/**
+	 * Registered sections, keyed by their content hash
+	 */
+	std::unordered_multimap<uint64_t, std::weak_ptr<ChunkSection>> m_sections;
+
+	/**
+	 * Number of registered sections right after expired entries were last removed
+	 */
+	size_t m_numSectionsAfterPrune;
+
+	/**
+	 * Number of sections that were replaced by an identical registered section
+	 */
+	uint64_t m_numDeduplicatedSections;
+
+public:
+	/**
+	 * @brief Constructor
+	 */
+	SharedSectionTable();
+
+	/**
+	 * @brief Destructor
+	 */
+	~SharedSectionTable();
+
+	/**
+	 * @brief Gets the registered section with the same block data as the provided section,
+	 * registering the provided section if there is none
+	 * @param[in] section Section to look up
+	 * @return Registered section with the same content, or the provided section itself
+	 */
+	std::shared_ptr<ChunkSection> Share(const std::shared_ptr<ChunkSection>& section);
+
+	/**
+	 * @brief Removes the entries of sections that were freed
+	 */
+	void Prune();
+
+	/**
+	 * @brief Removes every entry
+	 */
+	void Clear();
+
+	/**
+	 * @brief Gets the number of registered sections, including ones that may have been freed since the last prune
+	 * @return Number of entries
+	 */
+	size_t GetEntryCount() const;
+
+	/**
+	 * @brief Gets the number of sections that were replaced by an identical registered section
+	 * @return Number of deduplicated sections
+	 */
+	uint64_t GetDeduplicatedSectionCount() const;
+
+	/**
+	 * @brief Gets the number of bytes used by the table itself, not counting the sections
+	 * @return Memory usage in bytes
+	 */
+	size_t GetMemoryUsage() const;
+};
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "Constants.hpp"
+
+#include <cstdint>
+#include <glm/glm.hpp>
+
+/**
+ * Class containing conversions between world positions, block positions, chunk indices and
+ * positions of blocks within their chunk.
+ *
+ * Chunk dimensions are powers of two, so the conversions are shifts and masks instead of
+ * divisions and modulos. Arithmetic right shifts and two's complement masks round towards
+ * negative infinity, which makes them correct for negative coordinates as well.
+ * The functions are defined here so that they can be inlined into the loops that call them.
+ */
+class CoordinateUtils
+{
+public:
+    /**
+     * Number of bits of a block x-coordinate that index within a chunk
+     */
+    static const int CHUNK_WIDTH_BITS = 4;
+
+    /**
+     * Number of bits of a block y-coordinate that index within a chunk
+     */
+    static const int CHUNK_HEIGHT_BITS = 4;
+
+    /**
+     * Number of bits of a block z-coordinate that index within a chunk
+     */
+    static const int CHUNK_DEPTH_BITS = 4;
+
+    /**
+     * Number of bits of each axis in a packed chunk key. Enough for any index the world can reach.
+     */
+    static const int CHUNK_KEY_AXIS_BITS = 21;
+
+    static_assert((1 << CHUNK_WIDTH_BITS) == Constants::CHUNK_WIDTH, "Chunk width should be 2 to the power of CHUNK_WIDTH_BITS");
+    static_assert((1 << CHUNK_HEIGHT_BITS) == Constants::CHUNK_HEIGHT, "Chunk height should be 2 to the power of CHUNK_HEIGHT_BITS");
+    static_assert((1 << CHUNK_DEPTH_BITS) == Constants::CHUNK_DEPTH, "Chunk depth should be 2 to the power of CHUNK_DEPTH_BITS");
+    static_assert((-1 >> 1) == -1, "Right shifts of negative values should be arithmetic");
+
+    /**
+     * @brief Rounds the value down to an integer
+     * @param[in] value Value to round
+     * @return Largest integer not greater than the value
+     */
+    static int FloorToInt(const float &value)
+    {
+        // Truncation rounds towards zero, so negative values with a fraction are one too high
+        int truncated = static_cast<int>(value);
+        return truncated - static_cast<int>(value < static_cast<float>(truncated));
+    }
+
+    /**
+     * @brief Converts the world position to the position of the block containing it
+     * @param[in] worldPosition World position
+     * @return Block position in the world
+     */
+    static glm::ivec3 WorldToBlockPosition(const glm::vec3 &worldPosition)
+    {
+        glm::vec3 scaledPosition = worldPosition * (1.0f / Constants::BLOCK_SIZE);
+        return glm::ivec3(FloorToInt(scaledPosition.x), FloorToInt(scaledPosition.y), FloorToInt(scaledPosition.z));
+    }
+
+    /**
+     * @brief Gets the chunk index of the chunk containing the block
+     * @param[in] blockPosition Block position in the world
+     * @return Chunk index
+     */
+    static glm::ivec3 BlockToChunkIndex(const glm::ivec3 &blockPosition)
+    {
+        return glm::ivec3(blockPosition.x >> CHUNK_WIDTH_BITS, blockPosition.y >> CHUNK_HEIGHT_BITS, blockPosition.z >> CHUNK_DEPTH_BITS);
+    }
+
+    /**
+     * @brief Gets the position of the block within the chunk containing it
+     * @param[in] blockPosition Block position in the world
+     * @return Block position within the chunk
+     */
+    static glm::ivec3 BlockToLocalPosition(const glm::ivec3 &blockPosition)
+    {
+        return glm::ivec3(blockPosition.x & (Constants::CHUNK_WIDTH - 1), blockPosition.y & (Constants::CHUNK_HEIGHT - 1), blockPosition.z & (Constants::CHUNK_DEPTH - 1));
+    }
+
+    /**
+     * @brief Gets the position of the block at the specified position within a chunk
+     * @param[in] chunkIndex Chunk index
+     * @param[in] localPosition Block position within the chunk
+     * @return Block position in the world
+     */
+    static glm::ivec3 LocalToBlockPosition(const glm::ivec3 &chunkIndex, const glm::ivec3 &localPosition)
+    {
+        // Multiplying instead of shifting left avoids undefined behavior for negative indices, and compiles to the same shift
+        return glm::ivec3(chunkIndex.x * Constants::CHUNK_WIDTH + localPosition.x,
+            chunkIndex.y * Constants::CHUNK_HEIGHT + localPosition.y,
+            chunkIndex.z * Constants::CHUNK_DEPTH + localPosition.z);
+    }
+
+    /**
+     * @brief Gets the chunk index of the chunk containing the world position
+     * @param[in] worldPosition World position
+     * @return Chunk index
+     */
+    static glm::ivec3 WorldToChunkIndex(const glm::vec3 &worldPosition)
+    {
+        return BlockToChunkIndex(WorldToBlockPosition(worldPosition));
+    }
+
+    /**
+     * @brief Gets the position within its chunk of the block containing the world position
+     * @param[in] worldPosition World position
+     * @return Block position within the chunk
+     */
+    static glm::ivec3 WorldToLocalPosition(const glm::vec3 &worldPosition)
+    {
+        return BlockToLocalPosition(WorldToBlockPosition(worldPosition));
+    }
+
+    /**
+     * @brief Packs chunk or region indices into a single key.
+     * Every map keyed by chunk indices uses this packing, so that their keys agree.
+     * @param[in] indexX X-index
+     * @param[in] indexY Y-index
+     * @param[in] indexZ Z-index
+     * @return Packed key
+     */
+    static uint64_t PackChunkIndex(const int &indexX, const int &indexY, const int &indexZ)
+    {
+        const uint64_t mask = (static_cast<uint64_t>(1) << CHUNK_KEY_AXIS_BITS) - 1;
+        return ((static_cast<uint64_t>(static_cast<uint32_t>(indexX)) & mask) << (2 * CHUNK_KEY_AXIS_BITS))
+            | ((static_cast<uint64_t>(static_cast<uint32_t>(indexY)) & mask) << CHUNK_KEY_AXIS_BITS)
+            | (static_cast<uint64_t>(static_cast<uint32_t>(indexZ)) & mask);
+    }
+};
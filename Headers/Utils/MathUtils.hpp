@@ -2,6 +2,8 @@
 
 #include <glm/glm.hpp>
 
+#include <cstdint>
+
 /**
  * Class containing utility math functions
  */
@@ -25,4 +27,11 @@ public:
      * @return Interpolated value
      */
     static glm::vec4 Lerp(const glm::vec4 &a, const glm::vec4 &b, const float &t);
+
+    /**
+     * @brief Gets the index of the lowest set bit
+     * @param[in] value Value to check. Should not be 0.
+     * @return Number of trailing zero bits
+     */
+    static int CountTrailingZeros(const uint64_t &value);
 };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "FastNoiseLite/FastNoiseLite.h"
+#include <cstddef>
 #include <cstdint>
 
 /**
@@ -20,4 +21,23 @@ public:
      * @param[in] lacunarity Lacunarity
      */
     static float GetOctaveNoise(FastNoiseLite &noiseEngine, const float &x, const float &y, const uint32_t &numOctaves, const float &scale, const float &persistence, const float &lacunarity);
+
+    /**
+     * @brief Fills a grid with noise values with octaves applied, four samples at a time where SSE2 is available.
+     * Gives the same values as calling GetOctaveNoise() for every sample with a FastNoiseLite engine
+     * that uses OpenSimplex2 noise without fractal, and the provided seed and frequency.
+     * @param[in] seed Seed of the noise
+     * @param[in] frequency Frequency of the noise engine
+     * @param[in] x X-coordinate of the first sample
+     * @param[in] y Y-coordinate of the first sample
+     * @param[in] width Number of samples along the x-axis, one unit apart
+     * @param[in] height Number of samples along the y-axis, one unit apart
+     * @param[in] numOctaves Number of octaves
+     * @param[in] scale Scale
+     * @param[in] persistence Persistence
+     * @param[in] lacunarity Lacunarity
+     * @param[out] values Noise values. The sample at (x + i, y + j) is written to index j * width + i.
+     */
+    static void GetOctaveNoiseGrid(const int &seed, const float &frequency, const float &x, const float &y, const size_t &width, const size_t &height,
+        const uint32_t &numOctaves, const float &scale, const float &persistence, const float &lacunarity, float *values);
 };
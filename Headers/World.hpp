@@ -1,40 +1,280 @@
 #pragma once
 
+#include "BlockHandle.hpp"
 #include "Camera.hpp"
 #include "Chunk.hpp"
+#include "ChunkCache.hpp"
+#include "ChunkContainers/BaseChunkContainer.hpp"
+#include "ChunkPool.hpp"
+#include "ChunkReclaimer.hpp"
+#include "Constants.hpp"
+#include "Enums/ChunkContainerTypeEnum.hpp"
+#include "Enums/ChunkGenerationModeEnum.hpp"
+#include "Enums/ChunkIOBackendEnum.hpp"
+#include "Enums/ChunkStateEnum.hpp"
+#include "GLDeletionQueue.hpp"
+#include "IO/BaseChunkIO.hpp"
+#include "Jobs/JobSystem.hpp"
+#include "MemoryReport.hpp"
 #include "Ray.hpp"
+#include "RegionFile.hpp"
+#include "SharedSectionTable.hpp"
 #include "WorldGenParams.hpp"
 
-#include <FastNoiseLite/FastNoiseLite.h>
-
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+/**
+ * Number of chunks in each stage of their lifecycle, indexed by ChunkStateEnum
+ */
+typedef std::array<size_t, static_cast<size_t>(ChunkStateEnum::COUNT)> ChunkStateCounts;
+
 /**
  * World data class
  */
 class World
 {
 private:
+	/**
+	 * Chunk save whose data is still being written to its region file
+	 */
+	struct PendingChunkWrite
+	{
+		/**
+		 * Data of the most recent save of the chunk
+		 */
+		std::shared_ptr<std::vector<uint8_t>> data;
+
+		/**
+		 * Number of writes of the chunk that have not completed yet
+		 */
+		size_t numInFlight;
+
+		/**
+		 * Chunk index of the saved chunk
+		 */
+		glm::ivec3 chunkIndex;
+
+		/**
+		 * Region file the data is written to
+		 */
+		RegionFile* regionFile;
+
+		/**
+		 * Offset in the region file of the pages reserved for the data
+		 */
+		uint64_t offset;
+
+		/**
+		 * Number of times in a row that writing the data failed
+		 */
+		uint32_t numFailedWrites;
+	};
+
+	/**
+	 * Chunk going through the generate, mesh and upload jobs, or through the steps of the time-sliced generation
+	 */
+	struct PendingChunkGeneration
+	{
+		/**
+		 * Chunk being generated. Only the jobs touch it until the upload job completes.
+		 */
+		Chunk* chunk;
+
+		/**
+		 * Token of the chunk, checked by the jobs to skip the remaining work once the chunk is no longer needed
+		 */
+		CancellationToken cancellationToken;
+
+		/**
+		 * Serialized edit journal applied on top of the generated terrain. Empty if the chunk has no saved edits.
+		 */
+		std::vector<uint8_t> savedEdits;
+
+		/**
+		 * Flag indicating that a job stopped early because the chunk was cancelled
+		 */
+		bool isCancelled;
+
+		/**
+		 * Last job of the chunk, which uploads its meshes on the main thread. nullptr until the jobs are submitted.
+		 */
+		std::shared_ptr<Job> uploadJob;
+
+		/**
+		 * Order in which queued chunks are submitted. Chunks with lower values are submitted first.
+		 */
+		float priority;
+
+		/**
+		 * Number of steps of the time-sliced generation that were done so far
+		 */
+		int numCompletedSteps;
+	};
+
 	/**
 	 * List of chunks
 	 */
 	std::vector<Chunk*> m_chunks;
 
 	/**
-	 * Noise generator
+	 * Container used to look up chunks by their chunk indices
+	 */
+	BaseChunkContainer* m_chunkContainer;
+
+	/**
+	 * Pool of unloaded chunks that can be reused
+	 */
+	ChunkPool m_chunkPool;
+
+	/**
+	 * Cache of chunks outside the loaded area that can be restored without generating them again
+	 */
+	ChunkCache m_chunkCache;
+
+	/**
+	 * GL objects of deleted chunks, waiting to be deleted on the render thread
+	 */
+	GLDeletionQueue m_glDeletionQueue;
+
+	/**
+	 * Deletes chunks that do not fit in the chunk pool on a background thread
+	 */
+	ChunkReclaimer m_chunkReclaimer;
+
+	/**
+	 * Sections that chunks with identical block data can share
 	 */
-	FastNoiseLite m_noiseEngine;
+	SharedSectionTable m_sharedSections;
 
 	/**
 	 * World generation parameters
 	 */
 	WorldGenParams m_worldGenParams;
 
+	/**
+	 * Directory where region files are stored. Chunks are not saved if this is empty.
+	 */
+	std::string m_saveDirectory;
+
+	/**
+	 * Region files that have been opened, keyed by their packed region indices.
+	 * An entry is nullptr if the region file could not be opened.
+	 */
+	std::unordered_map<uint64_t, RegionFile*> m_regionFiles;
+
+	/**
+	 * Backend reading and writing saved chunk data in the background
+	 */
+	BaseChunkIO* m_chunkIO;
+
+	/**
+	 * Saves that are still being written, keyed by packed chunk indices.
+	 * The region file may not hold the data of these chunks yet, so loads use the data kept here instead.
+	 * Saves of chunks that are no longer loaded stay here after their writes failed, until SaveChunks() writes them again.
+	 */
+	std::unordered_map<uint64_t, PendingChunkWrite> m_pendingWrites;
+
+	/**
+	 * Packed chunk indices of the chunks whose saved data is being read, or is read again on the next call to PollChunkIO()
+	 */
+	std::unordered_set<uint64_t> m_pendingLoads;
+
+	/**
+	 * Chunk indices of the chunks whose saved data failed to read, to be read again on the next call to PollChunkIO()
+	 */
+	std::vector<glm::ivec3> m_failedLoads;
+
+	/**
+	 * Number of times in a row that reading the saved data failed, keyed by packed chunk indices
+	 */
+	std::unordered_map<uint64_t, uint32_t> m_numFailedReads;
+
+	/**
+	 * Center chunk index of the area passed to the last call to LoadChunksWithinArea().
+	 * Chunks whose saved data is read after they left the area are not loaded.
+	 */
+	glm::ivec3 m_loadCenter;
+
+	/**
+	 * Horizontal radius in chunks of the area passed to the last call to LoadChunksWithinArea()
+	 */
+	int m_loadRadius;
+
+	/**
+	 * Vertical radius in chunks of the area passed to the last call to LoadChunksWithinArea()
+	 */
+	int m_loadVerticalRadius;
+
+	/**
+	 * Whether new chunks are generated on the job system or time-sliced on the main thread
+	 */
+	ChunkGenerationModeEnum m_chunkGenerationMode;
+
+	/**
+	 * Job system generating and meshing new chunks on worker threads. Has no worker threads in time-sliced mode.
+	 */
+	JobSystem* m_jobSystem;
+
+	/**
+	 * Chunks whose jobs were submitted, in the order they were submitted
+	 */
+	std::deque<PendingChunkGeneration*> m_chunkGenerations;
+
+	/**
+	 * Requested chunks whose jobs were not submitted yet, sorted by decreasing priority value so that the next chunk to submit is at the back
+	 */
+	std::vector<PendingChunkGeneration*> m_queuedGenerations;
+
+	/**
+	 * Flag indicating that the queued chunks have to be sorted again before the next ones are submitted
+	 */
+	bool m_isGenerationQueueDirty;
+
+	/**
+	 * Position of the camera, used to generate the chunks closest to it first
+	 */
+	glm::vec3 m_viewPosition;
+
+	/**
+	 * Direction the camera is looking at, used to generate the chunks in front of it first
+	 */
+	glm::vec3 m_viewDirection;
+
+	/**
+	 * Queued and submitted chunks, keyed by packed chunk indices.
+	 * Chunks that left the loaded area are cancelled and removed from here, and are not added to the world once their jobs complete.
+	 */
+	std::unordered_map<uint64_t, Chunk*> m_generatingChunks;
+
+	/**
+	 * Chunk whose time-sliced generation is resumed on the next call to GenerateChunksForTime(). nullptr if there is none.
+	 */
+	PendingChunkGeneration* m_timeSlicedGeneration;
+
 public:
 	/**
 	 * @brief Constructor
+	 * @param[in] chunkContainerType Type of container used to look up chunks
+	 * @param[in] maxLoadRadius Largest radius in chunks that will be passed to LoadChunksWithinArea().
+	 * Only used to size the ring buffer container.
+	 * @param[in] maxVerticalLoadRadius Largest vertical radius in chunks that will be passed to LoadChunksWithinArea().
+	 * Only used to size the ring buffer container.
+	 * @param[in] chunkIOBackend Backend used to read and write saved chunks. Falls back to the thread pool if io_uring is not available.
+	 * @param[in] numWorkerThreads Number of job system threads generating and meshing new chunks.
+	 * If 0, one thread is started for every core except the one running the main thread.
+	 * @param[in] chunkGenerationMode Whether new chunks are generated on the job system threads or time-sliced on the main thread.
+	 * No job system thread is started in time-sliced mode.
 	 */
-	World();
+	World(const ChunkContainerTypeEnum& chunkContainerType = ChunkContainerTypeEnum::HASH_MAP, const int& maxLoadRadius = 8,
+		const int& maxVerticalLoadRadius = Constants::VERTICAL_LOAD_RADIUS, const ChunkIOBackendEnum& chunkIOBackend = ChunkIOBackendEnum::IO_URING,
+		const size_t& numWorkerThreads = 0, const ChunkGenerationModeEnum& chunkGenerationMode = ChunkGenerationModeEnum::JOB_SYSTEM);
 
 	/**
 	 * @brief Destructor
@@ -42,18 +282,27 @@ public:
 	~World();
 
 	/**
-	 * @brief Sets the parameters for the world generation
+	 * @brief Sets the parameters for the world generation.
+	 * Waits for the chunks that are partly generated, which keep the previous parameters.
 	 * @param[in] params Struct containing the parameters for the world generation
 	 */
 	void SetWorldGenParams(const WorldGenParams &params);
 
+	/**
+	 * @brief Sets the directory where modified chunks are saved, creating it if needed.
+	 * Should be called before any chunk is loaded.
+	 * @param[in] saveDirectory Path to the save directory. Saving is disabled if this is empty.
+	 */
+	void SetSaveDirectory(const std::string& saveDirectory);
+
 	/**
 	 * @brief Get chunk at the provided location indices
 	 * @param[in] chunkIndexX Chunk x-index
+	 * @param[in] chunkIndexY Chunk y-index
 	 * @param[in] chunkIndexZ Chunk z-index
 	 * @return Chunk at the provided location. Returns nullptr if the chunk has not been generated yet.
 	 */
-	Chunk* GetChunkAt(const int& chunkIndexX, const int& chunkIndexZ);
+	Chunk* GetChunkAt(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ);
 
 	/**
 	 * @brief Gets the chunk at the given world position
@@ -65,9 +314,9 @@ public:
 	/**
 	 * @brief Gets the block at the given world position
 	 * @param[in] worldPosition World position
-	 * @return Block at the given world position
+	 * @return Handle to the block at the given world position. The handle is not valid if the position is not in a loaded chunk.
 	 */
-	Block* GetBlockAtWorldPosition(const glm::vec3& worldPosition);
+	BlockHandle GetBlockAtWorldPosition(const glm::vec3& worldPosition);
 
 	/**
 	 * @brief Converts the provided world position to chunk index
@@ -77,28 +326,76 @@ public:
 	glm::ivec3 WorldPositionToChunkIndex(const glm::vec3& worldPosition);
 
 	/**
-	 * @brief Generate chunk at the provided location indices
+	 * @brief Generate chunk at the provided location indices on the calling thread, applying any edits saved for it
 	 * @param[in] chunkIndexX Chunk x-index
+	 * @param[in] chunkIndexY Chunk y-index
 	 * @param[in] chunkIndexZ Chunk z-index
 	 * @return Generated chunk
 	 */
-	Chunk* GenerateChunkAt(const int& chunkIndexX, const int& chunkIndexZ);
+	Chunk* GenerateChunkAt(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ);
+
+	/**
+	 * @brief Loads the chunk at the provided location indices from its saved block data, reading it on the calling thread
+	 * @param[in] chunkIndexX Chunk x-index
+	 * @param[in] chunkIndexY Chunk y-index
+	 * @param[in] chunkIndexZ Chunk z-index
+	 * @return Loaded chunk. Returns nullptr if the chunk was never saved.
+	 */
+	Chunk* LoadChunkAt(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ);
+
+	/**
+	 * @brief Saves the chunk to its region file if it has unsaved changes.
+	 * Chunks are saved as a journal of their edits when that is smaller than their complete block data.
+	 * The data is written in the background once the chunk I/O batch is submitted.
+	 * @param[in] chunk Chunk to save
+	 */
+	void SaveChunk(Chunk* chunk);
+
+	/**
+	 * @brief Saves every loaded chunk that has unsaved changes, writes the saves that failed earlier again,
+	 * and waits until every pending write has completed
+	 */
+	void SaveChunks();
+
+	/**
+	 * @brief Reads the chunks whose reads failed again, loads the chunks whose saved data finished reading, runs the main thread jobs, adds the chunks whose jobs
+	 * completed to the world, and submits the chunk I/O requested since the last call. Should be called once per frame.
+	 */
+	void PollChunkIO();
+
+	/**
+	 * @brief Generates and meshes the queued chunks on the calling thread, a slice of blocks or a section at a time,
+	 * until the time budget runs out. The chunk that is not done yet is resumed on the next call.
+	 * Does nothing unless the world was created with ChunkGenerationModeEnum::TIME_SLICED. Should be called once per frame.
+	 * @param[in] timeBudget Time budget in milliseconds
+	 */
+	void GenerateChunksForTime(const float& timeBudget);
+
+	/**
+	 * @brief Sets the camera position and direction used to decide which requested chunks are generated first.
+	 * Chunks close to the camera and in front of it are generated before the others.
+	 * @param[in] position Camera position
+	 * @param[in] direction Direction the camera is looking at
+	 */
+	void SetViewpoint(const glm::vec3& position, const glm::vec3& direction);
 
 	/**
 	 * @brief Load chunks around the area defined by the center chunk index
-	 * and the radius in chunks
+	 * and the radius in chunks. Chunks outside the world height are never loaded.
 	 * @param[in] centerChunkIndex Center chunk index
-	 * @param[in] radius Radius in chunks
+	 * @param[in] radius Horizontal radius in chunks
+	 * @param[in] verticalRadius Vertical radius in chunks
 	 */
-	void LoadChunksWithinArea(const glm::ivec3& centerChunkIndex, const int& radius);
+	void LoadChunksWithinArea(const glm::ivec3& centerChunkIndex, const int& radius, const int& verticalRadius = Constants::VERTICAL_LOAD_RADIUS);
 
 	/**
 	 * @brief Unload chunks outside the area defined by the center chunk index
-	 * and the radius in chunks
+	 * and the radius in chunks. Unloaded chunks are kept in the chunk cache while it is within its budget.
 	 * @param[in] centerChunkIndex Center chunk index
-	 * @param radius Radius in chunks
+	 * @param radius Horizontal radius in chunks
+	 * @param verticalRadius Vertical radius in chunks
 	 */
-	void UnloadChunksOutsideArea(const glm::ivec3& centerChunkIndex, const int& radius);
+	void UnloadChunksOutsideArea(const glm::ivec3& centerChunkIndex, const int& radius, const int& verticalRadius = Constants::VERTICAL_LOAD_RADIUS);
 
 	/**
 	 * @brief Draws the terrain meshes
@@ -114,7 +411,365 @@ public:
 	 * @brief Casts a ray and gets the first non-air block hit
 	 * @param ray Ray
 	 * @param maxDistance Maximum distance
-	 * @return First non-air block hit by the ray cast. If no blocks are hit, returns nullptr.
+	 * @return Handle to the first non-air block hit by the ray cast. If no blocks are hit, the handle is not valid.
+	 */
+	BlockHandle Raycast(const Ray& ray, float maxDistance);
+
+	/**
+	 * @brief Gets the number of bytes used by the block data of all loaded chunks
+	 * @return Block data memory usage in bytes
+	 */
+	size_t GetBlockMemoryUsage() const;
+
+	/**
+	 * @brief Gets the memory used by the world, per chunk and aggregated per subsystem
+	 * @return Memory report
+	 */
+	WorldMemoryReport GetMemoryReport() const;
+
+	/**
+	 * @brief Writes the memory report to a text file
+	 * @param[in] filePath Path to the file
+	 * @return True if the file was written
+	 */
+	bool DumpMemoryReport(const std::string& filePath) const;
+
+	/**
+	 * @brief Gets the pool of unloaded chunks
+	 * @return Chunk pool
+	 */
+	const ChunkPool& GetChunkPool() const;
+
+	/**
+	 * @brief Sets the maximum number of bytes that chunks outside the loaded area can use
+	 * @param[in] budget Budget in bytes
+	 */
+	void SetChunkCacheBudget(const size_t& budget);
+
+	/**
+	 * @brief Gets the cache of chunks outside the loaded area
+	 * @return Chunk cache
+	 */
+	const ChunkCache& GetChunkCache() const;
+
+	/**
+	 * @brief Gets the background deleter of chunks that do not fit in the chunk pool
+	 * @return Chunk reclaimer
+	 */
+	const ChunkReclaimer& GetChunkReclaimer() const;
+
+	/**
+	 * @brief Gets the job system generating and meshing new chunks
+	 * @return Job system
+	 */
+	const JobSystem& GetJobSystem() const;
+
+	/**
+	 * @brief Gets the backend reading and writing saved chunk data
+	 * @return Chunk I/O backend
+	 */
+	const BaseChunkIO& GetChunkIO() const;
+
+	/**
+	 * @brief Gets the GL objects waiting to be deleted
+	 * @return GL deletion queue
+	 */
+	const GLDeletionQueue& GetGLDeletionQueue() const;
+
+	/**
+	 * @brief Deletes the GL objects of chunks that were deleted since the last call.
+	 * Should be called once per frame on the render thread.
+	 */
+	void FlushDeferredDeletions();
+
+	/**
+	 * @brief Gets the table of sections shared between chunks
+	 * @return Shared section table
+	 */
+	const SharedSectionTable& GetSharedSections() const;
+
+	/**
+	 * @brief Gets the number of loaded chunks
+	 * @return Number of loaded chunks
+	 */
+	size_t GetLoadedChunkCount() const;
+
+	/**
+	 * @brief Gets the number of loaded and cached chunks in each stage of their lifecycle
+	 * @return Number of chunks, indexed by ChunkStateEnum
+	 */
+	ChunkStateCounts GetChunkStateCounts() const;
+
+private:
+	/**
+	 * @brief Gets the chunk at the provided location indices, starting the search from a nearby chunk.
+	 * If the target chunk is adjacent to the starting chunk, the neighbor link is used instead of a lookup.
+	 * @param[in] fromChunk Chunk to start from. Can be nullptr.
+	 * @param[in] chunkIndexX Chunk x-index
+	 * @param[in] chunkIndexY Chunk y-index
+	 * @param[in] chunkIndexZ Chunk z-index
+	 * @return Chunk at the provided location. Returns nullptr if the chunk has not been generated yet.
+	 */
+	Chunk* GetChunkNear(Chunk* fromChunk, const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ);
+
+	/**
+	 * @brief Gets the block at the given world position within the specified chunk
+	 * @param[in] chunk Chunk containing the world position. Can be nullptr.
+	 * @param[in] worldPosition World position
+	 * @return Handle to the block at the given world position. The handle is not valid if the position is not in the chunk.
+	 */
+	BlockHandle GetBlockInChunkAtWorldPosition(Chunk* chunk, const glm::vec3& worldPosition);
+
+	/**
+	 * @brief Gets the distance along the ray at which it leaves the horizontal slice of the chunk between the specified heights
+	 * @param[in] ray Ray
+	 * @param[in] chunk Chunk containing the slice
+	 * @param[in] minY Bottom of the slice, in blocks
+	 * @param[in] maxY Top of the slice (exclusive), in blocks
+	 * @return Distance along the ray at which it exits the slice
+	 */
+	static float GetChunkSliceExitDistance(const Ray& ray, Chunk* chunk, const int& minY, const int& maxY);
+
+	/**
+	 * @brief Adds the chunk to the chunk list and links it with its loaded neighbors
+	 * @param[in] chunk Chunk to add
+	 * @return True if the chunk was added, false if the chunk container has no room for it
+	 */
+	bool AddChunk(Chunk* chunk);
+
+	/**
+	 * @brief Unlinks the chunk from its neighbors and removes it from the chunk index.
+	 * Does not remove the chunk from the chunk list.
+	 * @param[in] chunk Chunk to remove
+	 */
+	void RemoveChunkFromIndex(Chunk* chunk);
+
+	/**
+	 * @brief Gets the region file containing the chunk at the provided location indices, opening it if needed
+	 * @param[in] chunkIndexX Chunk x-index
+	 * @param[in] chunkIndexY Chunk y-index
+	 * @param[in] chunkIndexZ Chunk z-index
+	 * @param[out] localX Chunk x-index within the region
+	 * @param[out] localY Chunk y-index within the region
+	 * @param[out] localZ Chunk z-index within the region
+	 * @return Region file. Returns nullptr if saving is disabled or the region file could not be opened.
+	 */
+	RegionFile* GetRegionFile(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ, int& localX, int& localY, int& localZ);
+
+	/**
+	 * @brief Generate chunk at the provided location indices, applying the provided saved edits
+	 * @param[in] chunkIndexX Chunk x-index
+	 * @param[in] chunkIndexY Chunk y-index
+	 * @param[in] chunkIndexZ Chunk z-index
+	 * @param[in] savedEdits Serialized edit journal of the chunk. Can be nullptr if the chunk has no saved edits.
+	 * @param[in] savedEditsSize Size of the edit journal in bytes
+	 * @return Generated chunk
+	 */
+	Chunk* GenerateChunkAt(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ, const uint8_t* savedEdits, const size_t& savedEditsSize);
+
+	/**
+	 * @brief Queues the chunk at the provided location indices for generation.
+	 * The chunk is added to the world once it was generated and its meshes have been uploaded.
+	 * @param[in] chunkIndexX Chunk x-index
+	 * @param[in] chunkIndexY Chunk y-index
+	 * @param[in] chunkIndexZ Chunk z-index
+	 * @param[in] savedEdits Serialized edit journal of the chunk. Can be nullptr if the chunk has no saved edits.
+	 * @param[in] savedEditsSize Size of the edit journal in bytes
+	 */
+	void RequestChunkGeneration(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ, const uint8_t* savedEdits, const size_t& savedEditsSize);
+
+	/**
+	 * @brief If the view or the queue changed, releases the queued chunks that were cancelled and sorts the others by priority
+	 */
+	void SortQueuedGenerations();
+
+	/**
+	 * @brief Takes the queued chunk with the highest priority, releasing the cancelled chunks in front of it
+	 * @return Queued chunk. Returns nullptr if the queue is empty.
+	 */
+	PendingChunkGeneration* TakeQueuedGeneration();
+
+	/**
+	 * @brief Submits the queued chunks with the highest priority until the job system has enough chunks to work on.
+	 * Queued chunks that were cancelled are released.
+	 */
+	void SubmitQueuedGenerations();
+
+	/**
+	 * @brief Submits the jobs that generate the chunk, mesh it and upload the meshes
+	 * @param[in] generation Queued chunk
+	 */
+	void SubmitChunkGeneration(PendingChunkGeneration* generation);
+
+	/**
+	 * @brief Gets the priority of generating the chunk at the provided location indices,
+	 * based on its distance to the camera and its angle to the view direction
+	 * @param[in] chunkIndex Chunk index
+	 * @return Priority value. Chunks with lower values are generated first.
+	 */
+	float GetGenerationPriority(const glm::ivec3& chunkIndex) const;
+
+	/**
+	 * @brief Fills the chunk with the generated terrain, then applies the saved edits and compacts its sections.
+	 * Only touches the chunk and reads the generation parameters, so it can run on the job system threads.
+	 * @param[in] chunk Chunk that was just acquired from the chunk pool
+	 * @param[in] cancellationToken Token checked between columns of blocks
+	 * @param[in] savedEdits Serialized edit journal of the chunk. Can be nullptr if the chunk has no saved edits.
+	 * @param[in] savedEditsSize Size of the edit journal in bytes
+	 * @return True if the block data was generated, false if the generation was cancelled
+	 */
+	bool GenerateBlocks(Chunk* chunk, const CancellationToken& cancellationToken, const uint8_t* savedEdits, const size_t& savedEditsSize);
+
+	/**
+	 * @brief Fills one slice of columns of the chunk with the generated terrain
+	 * @param[in] chunk Chunk being generated
+	 * @param[in] x X-coordinate of the slice within the chunk
+	 */
+	void GenerateTerrainSlice(Chunk* chunk, const int& x);
+
+	/**
+	 * @brief Applies the saved edits on top of the generated terrain and compacts the sections of the chunk
+	 * @param[in] chunk Chunk whose terrain was generated
+	 * @param[in] savedEdits Serialized edit journal of the chunk. Can be nullptr if the chunk has no saved edits.
+	 * @param[in] savedEditsSize Size of the edit journal in bytes
+	 */
+	void FinishGeneratedBlocks(Chunk* chunk, const uint8_t* savedEdits, const size_t& savedEditsSize) const;
+
+	/**
+	 * @brief Does the next step of the time-sliced generation of the chunk:
+	 * a slice of terrain, the saved edits, the meshes of a section, or the upload of the meshes
+	 * @param[in] generation Chunk being generated
+	 * @return True if the meshes were uploaded and the chunk is ready to be added to the world
+	 */
+	bool AdvanceChunkGeneration(PendingChunkGeneration* generation);
+
+	/**
+	 * @brief Shares the sections of a chunk whose meshes were uploaded and adds it to the world
+	 * @param[in] chunk Generated chunk with uploaded meshes
+	 * @return Added chunk. Returns nullptr if there is no room for it.
+	 */
+	Chunk* FinishChunkGeneration(Chunk* chunk);
+
+	/**
+	 * @brief Adds the chunks whose jobs completed to the world, in the order they were submitted.
+	 * Chunks that were cancelled are released.
+	 */
+	void IntegrateGeneratedChunks();
+
+	/**
+	 * @brief Adds the chunk whose meshes were uploaded to the world, or releases it if it was cancelled, then deletes the pending generation
+	 * @param[in] generation Generated chunk
+	 */
+	void IntegrateGeneratedChunk(PendingChunkGeneration* generation);
+
+	/**
+	 * @brief Creates the chunk at the provided location indices from its serialized block data
+	 * @param[in] chunkIndexX Chunk x-index
+	 * @param[in] chunkIndexY Chunk y-index
+	 * @param[in] chunkIndexZ Chunk z-index
+	 * @param[in] blockData Serialized block data
+	 * @param[in] blockDataSize Size of the block data in bytes
+	 * @return Loaded chunk. Returns nullptr if the block data is corrupted.
+	 */
+	Chunk* DeserializeChunkAt(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ, const uint8_t* blockData, const size_t& blockDataSize);
+
+	/**
+	 * @brief Gets the saved data of the chunk at the provided location indices without waiting for the chunk I/O backend
+	 * @param[in] chunkIndexX Chunk x-index
+	 * @param[in] chunkIndexY Chunk y-index
+	 * @param[in] chunkIndexZ Chunk z-index
+	 * @param[out] data Saved data, starting with its payload type
+	 * @param[out] size Size of the saved data in bytes
+	 * @return True if the chunk was saved
+	 */
+	bool GetSavedChunkData(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ, const uint8_t*& data, size_t& size);
+
+	/**
+	 * @brief Starts reading the saved data of the chunk at the provided location indices.
+	 * The chunk is added to the world once the data has been read.
+	 * @param[in] chunkIndexX Chunk x-index
+	 * @param[in] chunkIndexY Chunk y-index
+	 * @param[in] chunkIndexZ Chunk z-index
+	 * @return True if the chunk is being loaded from its saved data, false if it was never saved and has to be generated
+	 */
+	bool RequestChunkLoad(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ);
+
+	/**
+	 * @brief Creates the chunk from its saved data, or starts generating it if the data is only a journal of edits
+	 * @param[in] chunkIndexX Chunk x-index
+	 * @param[in] chunkIndexY Chunk y-index
+	 * @param[in] chunkIndexZ Chunk z-index
+	 * @param[in] data Saved data, starting with its payload type
+	 * @param[in] size Size of the saved data in bytes
+	 */
+	void LoadChunkFromSavedData(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ, const uint8_t* data, const size_t& size);
+
+	/**
+	 * @brief Reads the saved data of the chunks whose reads failed during the previous call to PollChunkIO() again
+	 */
+	void RetryFailedLoads();
+
+	/**
+	 * @brief Loads the chunk whose saved data finished reading, unless it left the loaded area in the meantime.
+	 * Failed reads are tried again on the next call to PollChunkIO().
+	 * @param[in] chunkIndexX Chunk x-index
+	 * @param[in] chunkIndexY Chunk y-index
+	 * @param[in] chunkIndexZ Chunk z-index
+	 * @param[in] request Completed read request
+	 */
+	void FinishChunkLoad(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ, const ChunkIORequest& request);
+
+	/**
+	 * @brief Starts writing the data of the chunk save to the pages reserved for it
+	 * @param[in] pendingWrite Chunk save to write
+	 */
+	void WriteChunkData(PendingChunkWrite& pendingWrite);
+
+	/**
+	 * @brief Forgets the data of a chunk save once it has been written. Failed writes are tried again,
+	 * and once they keep failing the chunk is marked as unsaved if it is still loaded or cached.
+	 * @param[in] chunkIndexX Chunk x-index
+	 * @param[in] chunkIndexY Chunk y-index
+	 * @param[in] chunkIndexZ Chunk z-index
+	 * @param[in] request Completed write request
+	 */
+	void FinishChunkSave(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ, const ChunkIORequest& request);
+
+	/**
+	 * @brief Checks whether the chunk is within the area passed to the last call to LoadChunksWithinArea()
+	 * @param[in] chunkIndexX Chunk x-index
+	 * @param[in] chunkIndexY Chunk y-index
+	 * @param[in] chunkIndexZ Chunk z-index
+	 * @return True if the chunk is within the loaded area
+	 */
+	bool IsInsideLoadedArea(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ) const;
+
+	/**
+	 * @brief Applies a saved edit journal on top of the generated terrain of the chunk
+	 * @param[in] chunk Chunk with freshly generated terrain
+	 * @param[in] savedEdits Serialized edit journal
+	 * @param[in] savedEditsSize Size of the edit journal in bytes
+	 */
+	void ReplaySavedEdits(Chunk* chunk, const uint8_t* savedEdits, const size_t& savedEditsSize) const;
+
+	/**
+	 * @brief Moves the chunk at the provided location indices from the chunk cache back into the world
+	 * @param[in] chunkIndexX Chunk x-index
+	 * @param[in] chunkIndexY Chunk y-index
+	 * @param[in] chunkIndexZ Chunk z-index
+	 * @return Restored chunk. Returns nullptr if the chunk is not in the cache.
+	 */
+	Chunk* RestoreCachedChunkAt(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ);
+
+	/**
+	 * @brief Evicts chunks from the chunk cache until it fits in its budget, saving them if needed
+	 */
+	void EvictCachedChunks();
+
+	/**
+	 * @brief Returns the chunk to the chunk pool. If the pool is full, the GL objects of the chunk are queued
+	 * for deletion and the rest of the chunk is deleted on the reclaimer thread.
+	 * @param[in] chunk Chunk that was removed from the world and the chunk cache
 	 */
-	Block* Raycast(const Ray& ray, float maxDistance);
+	void ReleaseChunk(Chunk* chunk);
 };
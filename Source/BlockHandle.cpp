@@ -0,0 +1,87 @@
+#include "BlockHandle.hpp"
+
+#include "Chunk.hpp"
+#include "Constants.hpp"
+#include "Utils/CoordinateUtils.hpp"
+
+/**
+ * @brief Constructor. Creates a handle that does not refer to any block.
+ */
+BlockHandle::BlockHandle()
+	: chunk(nullptr)
+	, x(0)
+	, y(0)
+	, z(0)
+{
+}
+
+/**
+ * @brief Constructor
+ * @param[in] newChunk Chunk the block belongs to
+ * @param[in] positionInChunk Position of the block within the chunk
+ */
+BlockHandle::BlockHandle(Chunk* newChunk, const glm::ivec3& positionInChunk)
+	: chunk(newChunk)
+	, x(static_cast<uint8_t>(positionInChunk.x))
+	, y(static_cast<uint8_t>(positionInChunk.y))
+	, z(static_cast<uint8_t>(positionInChunk.z))
+{
+}
+
+/**
+ * @brief Checks whether this handle refers to a block in a loaded chunk
+ * @return True if this handle refers to a block, false otherwise
+ */
+bool BlockHandle::IsValid() const
+{
+	return chunk != nullptr;
+}
+
+/**
+ * @brief Gets the type of the referenced block
+ * @return Block type. Returns BlockTypeEnum::AIR if the handle is not valid.
+ */
+BlockTypeEnum BlockHandle::GetBlockType() const
+{
+	if (chunk == nullptr)
+	{
+		return BlockTypeEnum::AIR;
+	}
+
+	return chunk->GetBlockAt(x, y, z);
+}
+
+/**
+ * @brief Sets the type of the referenced block
+ * @param[in] type New block type
+ */
+void BlockHandle::SetBlockType(const BlockTypeEnum& type)
+{
+	if (chunk != nullptr)
+	{
+		chunk->SetBlockAt(x, y, z, type);
+	}
+}
+
+/**
+ * @brief Gets the position of the referenced block within the chunk
+ * @return Position of the block within the chunk
+ */
+glm::ivec3 BlockHandle::GetPositionInChunk() const
+{
+	return glm::ivec3(x, y, z);
+}
+
+/**
+ * @brief Gets the position of the referenced block in the world
+ * @return Position of the block in the world
+ */
+glm::ivec3 BlockHandle::GetPositionInWorld() const
+{
+	if (chunk == nullptr)
+	{
+		return glm::ivec3(x, y, z);
+	}
+
+	return CoordinateUtils::LocalToBlockPosition(chunk->GetChunkIndices(), glm::ivec3(x, y, z));
+}
@@ -0,0 +1,518 @@
+#include "BlockStorage.hpp"
+
+#include <cstring>
+
+/**
+ * @brief Constructor
+ * @param[in] size Number of entries in the storage
+ */
+BlockStorage::BlockStorage(const uint32_t& size)
+	: m_palette()
+	, m_data()
+	, m_bitsPerEntry(0)
+	, m_size(size)
+{
+	m_palette.push_back(BlockTypeEnum::AIR);
+}
+
+/**
+ * @brief Destructor
+ */
+BlockStorage::~BlockStorage()
+{
+}
+
+/**
+ * @brief Gets the block type at the specified index
+ * @param[in] index Entry index
+ * @return Block type at the specified index
+ */
+BlockTypeEnum BlockStorage::Get(const uint32_t& index) const
+{
+	return m_palette[GetPaletteIndex(index)];
+}
+
+/**
+ * @brief Sets the block type at the specified index
+ * @param[in] index Entry index
+ * @param[in] type New block type
+ */
+void BlockStorage::Set(const uint32_t& index, const BlockTypeEnum& type)
+{
+	uint32_t paletteIndex = GetOrAddPaletteIndex(type);
+	if (m_bitsPerEntry > 0)
+	{
+		SetPaletteIndex(index, paletteIndex);
+	}
+}
+
+/**
+ * @brief Resets every entry to air
+ */
+void BlockStorage::Clear()
+{
+	m_palette.clear();
+	m_palette.push_back(BlockTypeEnum::AIR);
+	m_data.clear();
+	m_bitsPerEntry = 0;
+}
+
+/**
+ * @brief Removes unused block types from the palette and repacks the data
+ * with the smallest number of bits per entry. If only one block type remains,
+ * the packed data is released and the storage holds that single value.
+ */
+void BlockStorage::Compact()
+{
+	if (m_bitsPerEntry == 0)
+	{
+		return;
+	}
+
+	std::vector<uint32_t> usageCounts(m_palette.size(), 0);
+	for (uint32_t i = 0; i < m_size; ++i)
+	{
+		++usageCounts[GetPaletteIndex(i)];
+	}
+
+	std::vector<BlockTypeEnum> newPalette;
+	std::vector<uint32_t> remap(m_palette.size(), 0);
+	for (size_t i = 0; i < m_palette.size(); ++i)
+	{
+		if (usageCounts[i] > 0)
+		{
+			remap[i] = static_cast<uint32_t>(newPalette.size());
+			newPalette.push_back(m_palette[i]);
+		}
+	}
+
+	m_palette.swap(newPalette);
+
+	if (m_palette.size() == 1)
+	{
+		std::vector<uint64_t>().swap(m_data);
+		m_bitsPerEntry = 0;
+		return;
+	}
+
+	uint32_t requiredBits = 1;
+	while ((1u << requiredBits) < m_palette.size())
+	{
+		requiredBits *= 2;
+	}
+
+	// Entries only move towards the start of the data when the entry size shrinks,
+	// so remapping front to back can be done in place
+	uint32_t oldBitsPerEntry = m_bitsPerEntry;
+	for (uint32_t i = 0; i < m_size; ++i)
+	{
+		m_bitsPerEntry = oldBitsPerEntry;
+		uint32_t paletteIndex = remap[GetPaletteIndex(i)];
+		m_bitsPerEntry = requiredBits;
+		SetPaletteIndex(i, paletteIndex);
+	}
+
+	uint32_t entriesPerWord = 64 / requiredBits;
+	m_data.resize((m_size + entriesPerWord - 1) / entriesPerWord);
+	std::vector<uint64_t>(m_data).swap(m_data);
+}
+
+/**
+ * @brief Checks whether every entry has the same block type
+ * @return True if every entry has the same block type, false otherwise
+ */
+bool BlockStorage::IsUniform() const
+{
+	return m_bitsPerEntry == 0;
+}
+
+/**
+ * @brief Gets the number of entries in the storage
+ * @return Number of entries
+ */
+uint32_t BlockStorage::GetSize() const
+{
+	return m_size;
+}
+
+/**
+ * @brief Gets the number of bits used by each packed index
+ * @return Number of bits per entry
+ */
+uint32_t BlockStorage::GetBitsPerEntry() const
+{
+	return m_bitsPerEntry;
+}
+
+/**
+ * @brief Gets the number of block types in the palette
+ * @return Palette size
+ */
+size_t BlockStorage::GetPaletteSize() const
+{
+	return m_palette.size();
+}
+
+/**
+ * @brief Gets the number of bytes used by this storage
+ * @return Memory usage in bytes
+ */
+size_t BlockStorage::GetMemoryUsage() const
+{
+	return sizeof(BlockStorage) + m_palette.capacity() * sizeof(BlockTypeEnum) + m_data.capacity() * sizeof(uint64_t);
+}
+
+/**
+ * @brief Appends the palette and packed data of this storage to the buffer
+ * @param[out] buffer Buffer to append to
+ */
+void BlockStorage::Serialize(std::vector<uint8_t>& buffer) const
+{
+	// Layout: bits per entry (1 byte), palette size (2 bytes), palette, packed words.
+	// Multi-byte values are written in host byte order.
+	uint16_t paletteSize = static_cast<uint16_t>(m_palette.size());
+	uint32_t entriesPerWord = m_bitsPerEntry == 0 ? 0 : 64 / m_bitsPerEntry;
+	size_t numWords = m_bitsPerEntry == 0 ? 0 : (m_size + entriesPerWord - 1) / entriesPerWord;
+
+	size_t offset = buffer.size();
+	buffer.resize(offset + 1 + sizeof(paletteSize) + m_palette.size() + numWords * sizeof(uint64_t));
+
+	buffer[offset] = static_cast<uint8_t>(m_bitsPerEntry);
+	offset += 1;
+	memcpy(&buffer[offset], &paletteSize, sizeof(paletteSize));
+	offset += sizeof(paletteSize);
+	for (size_t i = 0; i < m_palette.size(); ++i)
+	{
+		buffer[offset + i] = static_cast<uint8_t>(m_palette[i]);
+	}
+	offset += m_palette.size();
+	if (numWords > 0)
+	{
+		memcpy(&buffer[offset], m_data.data(), numWords * sizeof(uint64_t));
+	}
+}
+
+/**
+ * @brief Replaces the contents of this storage with serialized data.
+ * The data is validated, and the storage is left cleared if it is malformed.
+ * @param[in] data Serialized data
+ * @param[in] size Number of bytes available in the data
+ * @return Number of bytes read. Returns 0 if the data is malformed.
+ */
+size_t BlockStorage::Deserialize(const uint8_t* data, const size_t& size)
+{
+	Clear();
+
+	uint16_t paletteSize = 0;
+	if (size < 1 + sizeof(paletteSize))
+	{
+		return 0;
+	}
+
+	uint32_t bitsPerEntry = data[0];
+	memcpy(&paletteSize, data + 1, sizeof(paletteSize));
+	size_t offset = 1 + sizeof(paletteSize);
+
+	bool isValidBitCount = (bitsPerEntry == 0) || (bitsPerEntry == 1) || (bitsPerEntry == 2) || (bitsPerEntry == 4) || (bitsPerEntry == 8);
+	size_t maxPaletteSize = bitsPerEntry == 0 ? 1 : (1u << bitsPerEntry);
+	if (!isValidBitCount || (paletteSize == 0) || (paletteSize > maxPaletteSize))
+	{
+		return 0;
+	}
+
+	uint32_t entriesPerWord = bitsPerEntry == 0 ? 0 : 64 / bitsPerEntry;
+	size_t numWords = bitsPerEntry == 0 ? 0 : (m_size + entriesPerWord - 1) / entriesPerWord;
+	if (size - offset < paletteSize + numWords * sizeof(uint64_t))
+	{
+		return 0;
+	}
+
+	m_palette.resize(paletteSize);
+	for (size_t i = 0; i < paletteSize; ++i)
+	{
+		if (data[offset + i] >= static_cast<uint8_t>(BlockTypeEnum::COUNT))
+		{
+			Clear();
+			return 0;
+		}
+		m_palette[i] = static_cast<BlockTypeEnum>(data[offset + i]);
+	}
+	offset += paletteSize;
+
+	m_bitsPerEntry = bitsPerEntry;
+	if (numWords > 0)
+	{
+		m_data.resize(numWords);
+		memcpy(m_data.data(), data + offset, numWords * sizeof(uint64_t));
+		offset += numWords * sizeof(uint64_t);
+
+		// Every packed index has to refer to an entry in the palette
+		for (uint32_t i = 0; i < m_size; ++i)
+		{
+			if (GetPaletteIndex(i) >= paletteSize)
+			{
+				Clear();
+				return 0;
+			}
+		}
+	}
+
+	return offset;
+}
+
+/**
+ * @brief Appends the palette and the run-length encoded palette indices of this storage to the buffer.
+ * This is smaller than the serialized form for terrain, but slower to read back.
+ * @param[out] buffer Buffer to append to
+ */
+void BlockStorage::EncodeRuns(std::vector<uint8_t>& buffer) const
+{
+	// Layout: palette size (2 bytes), palette, then runs until every entry is covered.
+	// Each run is a palette index (1 byte) followed by its length as a base-128 varint.
+	uint16_t paletteSize = static_cast<uint16_t>(m_palette.size());
+	size_t offset = buffer.size();
+	buffer.resize(offset + sizeof(paletteSize) + m_palette.size());
+	memcpy(&buffer[offset], &paletteSize, sizeof(paletteSize));
+	offset += sizeof(paletteSize);
+	for (size_t i = 0; i < m_palette.size(); ++i)
+	{
+		buffer[offset + i] = static_cast<uint8_t>(m_palette[i]);
+	}
+
+	uint32_t runStart = 0;
+	while (runStart < m_size)
+	{
+		uint32_t paletteIndex = m_bitsPerEntry == 0 ? 0 : GetPaletteIndex(runStart);
+		uint32_t runEnd = runStart + 1;
+		if (m_bitsPerEntry == 0)
+		{
+			runEnd = m_size;
+		}
+		while ((runEnd < m_size) && (GetPaletteIndex(runEnd) == paletteIndex))
+		{
+			++runEnd;
+		}
+
+		buffer.push_back(static_cast<uint8_t>(paletteIndex));
+		uint32_t runLength = runEnd - runStart;
+		while (runLength >= 0x80)
+		{
+			buffer.push_back(static_cast<uint8_t>(runLength | 0x80));
+			runLength >>= 7;
+		}
+		buffer.push_back(static_cast<uint8_t>(runLength));
+
+		runStart = runEnd;
+	}
+}
+
+/**
+ * @brief Replaces the contents of this storage with run-length encoded data.
+ * The data is validated, and the storage is left cleared if it is malformed.
+ * @param[in] data Encoded data
+ * @param[in] size Number of bytes available in the data
+ * @return Number of bytes read. Returns 0 if the data is malformed.
+ */
+size_t BlockStorage::DecodeRuns(const uint8_t* data, const size_t& size)
+{
+	Clear();
+
+	uint16_t paletteSize = 0;
+	if (size < sizeof(paletteSize))
+	{
+		return 0;
+	}
+	memcpy(&paletteSize, data, sizeof(paletteSize));
+	size_t offset = sizeof(paletteSize);
+
+	if ((paletteSize == 0) || (paletteSize > 256) || (size - offset < paletteSize))
+	{
+		return 0;
+	}
+
+	const uint8_t* palette = data + offset;
+	for (size_t i = 0; i < paletteSize; ++i)
+	{
+		if (palette[i] >= static_cast<uint8_t>(BlockTypeEnum::COUNT))
+		{
+			return 0;
+		}
+	}
+	offset += paletteSize;
+
+	uint32_t runStart = 0;
+	while (runStart < m_size)
+	{
+		if ((offset >= size) || (data[offset] >= paletteSize))
+		{
+			Clear();
+			return 0;
+		}
+		BlockTypeEnum type = static_cast<BlockTypeEnum>(palette[data[offset]]);
+		++offset;
+
+		uint32_t runLength = 0;
+		uint32_t shift = 0;
+		bool hasMoreBytes = true;
+		while (hasMoreBytes)
+		{
+			if ((offset >= size) || (shift > 28))
+			{
+				Clear();
+				return 0;
+			}
+			runLength |= static_cast<uint32_t>(data[offset] & 0x7F) << shift;
+			hasMoreBytes = (data[offset] & 0x80) != 0;
+			shift += 7;
+			++offset;
+		}
+
+		if ((runLength == 0) || (runLength > m_size - runStart))
+		{
+			Clear();
+			return 0;
+		}
+
+		if (type != BlockTypeEnum::AIR)
+		{
+			for (uint32_t i = runStart; i < runStart + runLength; ++i)
+			{
+				Set(i, type);
+			}
+		}
+		runStart += runLength;
+	}
+
+	// Blocks were added to the palette one at a time, so the data may be packed wider than needed
+	Compact();
+	return offset;
+}
+
+/**
+ * @brief Gets a hash of the palette and packed data of this storage.
+ * Storages with the same blocks only get the same hash if their palettes are in the same order.
+ * @return Content hash
+ */
+uint64_t BlockStorage::GetContentHash() const
+{
+	// FNV-1a over the bits per entry, the palette and the packed words
+	const uint64_t FNV_PRIME = 1099511628211ull;
+	uint64_t hash = 14695981039346656037ull;
+
+	hash = (hash ^ m_bitsPerEntry) * FNV_PRIME;
+	for (size_t i = 0; i < m_palette.size(); ++i)
+	{
+		hash = (hash ^ static_cast<uint8_t>(m_palette[i])) * FNV_PRIME;
+	}
+	for (size_t i = 0; i < m_data.size(); ++i)
+	{
+		hash = (hash ^ m_data[i]) * FNV_PRIME;
+	}
+
+	return hash;
+}
+
+/**
+ * @brief Checks whether this storage has the same palette and packed data as another storage
+ * @param[in] other Storage to compare with
+ * @return True if both storages have the same content
+ */
+bool BlockStorage::HasSameContent(const BlockStorage& other) const
+{
+	return (m_bitsPerEntry == other.m_bitsPerEntry) && (m_size == other.m_size)
+		&& (m_palette == other.m_palette) && (m_data == other.m_data);
+}
+
+/**
+ * @brief Gets the palette index of the specified block type, adding it to the palette if needed
+ * @param[in] type Block type
+ * @return Palette index of the block type
+ */
+uint32_t BlockStorage::GetOrAddPaletteIndex(const BlockTypeEnum& type)
+{
+	for (size_t i = 0; i < m_palette.size(); ++i)
+	{
+		if (m_palette[i] == type)
+		{
+			return static_cast<uint32_t>(i);
+		}
+	}
+
+	m_palette.push_back(type);
+
+	uint32_t requiredBits = m_bitsPerEntry == 0 ? 1 : m_bitsPerEntry;
+	while ((1u << requiredBits) < m_palette.size())
+	{
+		requiredBits *= 2;
+	}
+	if (requiredBits != m_bitsPerEntry)
+	{
+		Repack(requiredBits);
+	}
+
+	return static_cast<uint32_t>(m_palette.size() - 1);
+}
+
+/**
+ * @brief Repacks the data with a different number of bits per entry
+ * @param[in] bitsPerEntry New number of bits per entry
+ */
+void BlockStorage::Repack(const uint32_t& bitsPerEntry)
+{
+	uint32_t oldBitsPerEntry = m_bitsPerEntry;
+	uint32_t entriesPerWord = 64 / bitsPerEntry;
+	size_t numWords = (m_size + entriesPerWord - 1) / entriesPerWord;
+
+	if (oldBitsPerEntry == 0)
+	{
+		// Every entry referred to palette index 0, which is all zeroes.
+		// assign() reuses the existing capacity if the storage was recycled.
+		m_data.assign(numWords, 0);
+		m_bitsPerEntry = bitsPerEntry;
+		return;
+	}
+
+	// Entries only move towards the end of the data when the entry size grows,
+	// so repacking back to front can be done in place
+	m_data.resize(numWords, 0);
+	for (uint32_t i = m_size; i > 0; --i)
+	{
+		m_bitsPerEntry = oldBitsPerEntry;
+		uint32_t paletteIndex = GetPaletteIndex(i - 1);
+		m_bitsPerEntry = bitsPerEntry;
+		SetPaletteIndex(i - 1, paletteIndex);
+	}
+}
+
+/**
+ * @brief Gets the palette index at the specified entry index
+ * @param[in] index Entry index
+ * @return Palette index
+ */
+uint32_t BlockStorage::GetPaletteIndex(const uint32_t& index) const
+{
+	if (m_bitsPerEntry == 0)
+	{
+		return 0;
+	}
+
+	uint32_t entriesPerWord = 64 / m_bitsPerEntry;
+	uint64_t mask = (1ull << m_bitsPerEntry) - 1;
+	uint64_t word = m_data[index / entriesPerWord];
+	return static_cast<uint32_t>((word >> ((index % entriesPerWord) * m_bitsPerEntry)) & mask);
+}
+
+/**
+ * @brief Sets the palette index at the specified entry index
+ * @param[in] index Entry index
+ * @param[in] paletteIndex Palette index
+ */
+void BlockStorage::SetPaletteIndex(const uint32_t& index, const uint32_t& paletteIndex)
+{
+	uint32_t entriesPerWord = 64 / m_bitsPerEntry;
+	uint32_t shift = (index % entriesPerWord) * m_bitsPerEntry;
+	uint64_t mask = ((1ull << m_bitsPerEntry) - 1) << shift;
+
+	uint64_t& word = m_data[index / entriesPerWord];
+	word = (word & ~mask) | ((static_cast<uint64_t>(paletteIndex) << shift) & mask);
+}
@@ -89,3 +89,23 @@ glm::vec3 BlockUtils::GetNormalFromFace(const BlockFaceEnum &face)
     if (face == BlockFaceEnum::BACK) return { 0.0f, 0.0f, 1.0f };
     return { 0.0f, 0.0f, 0.0f };
 }
+
+/**
+ * @brief Checks whether the specified block type is solid. Solid blocks hide the faces of the blocks next to them.
+ * @param[in] type Block type
+ * @return True if the block type is solid
+ */
+bool BlockUtils::IsSolid(const BlockTypeEnum &type)
+{
+    return (type != BlockTypeEnum::AIR) && (type != BlockTypeEnum::WATER);
+}
+
+/**
+ * @brief Checks whether the specified block type is a liquid
+ * @param[in] type Block type
+ * @return True if the block type is a liquid
+ */
+bool BlockUtils::IsLiquid(const BlockTypeEnum &type)
+{
+    return type == BlockTypeEnum::WATER;
+}
@@ -0,0 +1,33 @@
+#include "CancellationToken.hpp"
+
+/**
+ * @brief Constructor. Creates a token that is not cancelled.
+ */
+CancellationToken::CancellationToken()
+	: m_isCancelled(std::make_shared<std::atomic<bool>>(false))
+{
+}
+
+/**
+ * @brief Destructor
+ */
+CancellationToken::~CancellationToken()
+{
+}
+
+/**
+ * @brief Cancels this token and every copy of it
+ */
+void CancellationToken::Cancel()
+{
+	m_isCancelled->store(true, std::memory_order_release);
+}
+
+/**
+ * @brief Checks whether this token was cancelled
+ * @return True if the token was cancelled
+ */
+bool CancellationToken::IsCancelled() const
+{
+	return m_isCancelled->load(std::memory_order_acquire);
+}
@@ -1,7 +1,9 @@
 #include "Chunk.hpp"
 
 #include <array>
+#include <atomic>
 #include <cstddef>
+#include <cstring>
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
@@ -13,6 +15,7 @@
 #include "Constants.hpp"
 #include "Enums/BlockFaceEnum.hpp"
 #include "ResourceManager.hpp"
+#include "Utils/MathUtils.hpp"
 
 #include "Enums/BlockTypeEnum.hpp"
 #include "EntityTemplates/BlockTemplate.hpp"
@@ -22,16 +25,28 @@
 /**
  * @brief Constructor
  * @param[in] chunkIndexX Chunk x-index
+ * @param[in] chunkIndexY Chunk y-index
  * @param[in] chunkIndexZ Chunk z-index
  */
-Chunk::Chunk(const int& chunkIndexX, const int& chunkIndexZ)
+Chunk::Chunk(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ)
 	: m_terrainMesh()
 	, m_waterMesh()
-	, m_blocks()
-	, m_chunkIndex(chunkIndexX, 0, chunkIndexZ)
+	, m_sections()
+	, m_spareSections()
+	, m_heightMap()
+	, m_minHeight(Constants::CHUNK_HEIGHT)
+	, m_maxHeight(0)
+	, m_chunkIndex(chunkIndexX, chunkIndexY, chunkIndexZ)
+	, m_neighbors()
+	, m_version(0)
+	, m_savedVersion(0)
+	, m_editJournal()
+	, m_isRecordingEdits(false)
+	, m_compressedBlockData()
+	, m_isBlockDataCompressed(false)
+	, m_state(ChunkStateEnum::REQUESTED)
+	, m_cancellationToken()
 {
-	int size = Constants::CHUNK_WIDTH * Constants::CHUNK_DEPTH * Constants::CHUNK_HEIGHT;
-	m_blocks.resize(size);
 }
 
 /**
@@ -39,11 +54,51 @@ Chunk::Chunk(const int& chunkIndexX, const int& chunkIndexZ)
  */
 Chunk::~Chunk()
 {
-	for (size_t i = 0; i < m_blocks.size(); ++i)
+	// Snapshots keep their own references to shared sections
+	m_sections.fill(nullptr);
+	m_spareSections.clear();
+}
+
+/**
+ * @brief Resets this chunk to an empty chunk at the provided location indices,
+ * keeping its allocated sections, mesh buffers and GL objects for reuse
+ * @param[in] chunkIndexX Chunk x-index
+ * @param[in] chunkIndexY Chunk y-index
+ * @param[in] chunkIndexZ Chunk z-index
+ */
+void Chunk::Reset(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ)
+{
+	for (size_t i = 0; i < m_sections.size(); ++i)
 	{
-		delete m_blocks[i];
+		if (m_sections[i] != nullptr)
+		{
+			ReleaseSection(static_cast<int>(i));
+		}
 	}
-	m_blocks.clear();
+
+	m_terrainMesh.vertices.clear();
+	m_terrainMesh.indices.clear();
+	m_waterMesh.vertices.clear();
+	m_waterMesh.indices.clear();
+
+	m_heightMap.fill(0);
+	m_minHeight = Constants::CHUNK_HEIGHT;
+	m_maxHeight = 0;
+
+	m_chunkIndex = glm::ivec3(chunkIndexX, chunkIndexY, chunkIndexZ);
+	m_neighbors.fill(nullptr);
+	++m_version;
+
+	m_editJournal.Clear();
+	m_isRecordingEdits = false;
+
+	std::vector<uint8_t>().swap(m_compressedBlockData);
+	m_isBlockDataCompressed = false;
+
+	// Work still holding the token of the previous chunk should not touch this one
+	m_cancellationToken.Cancel();
+	m_cancellationToken = CancellationToken();
+	m_state = ChunkStateEnum::REQUESTED;
 }
 
 /**
@@ -82,6 +137,26 @@ glm::ivec3 Chunk::GetChunkIndices() const
 	return m_chunkIndex;
 }
 
+/**
+ * @brief Gets the neighboring chunk in the specified direction
+ * @param[in] neighbor Direction of the neighbor
+ * @return Neighboring chunk. Returns nullptr if the neighbor is not loaded.
+ */
+Chunk* Chunk::GetNeighbor(const ChunkNeighborEnum& neighbor) const
+{
+	return m_neighbors[static_cast<size_t>(neighbor)];
+}
+
+/**
+ * @brief Sets the neighboring chunk in the specified direction
+ * @param[in] neighbor Direction of the neighbor
+ * @param[in] chunk Neighboring chunk. Can be set to nullptr if the neighbor got unloaded.
+ */
+void Chunk::SetNeighbor(const ChunkNeighborEnum& neighbor, Chunk* chunk)
+{
+	m_neighbors[static_cast<size_t>(neighbor)] = chunk;
+}
+
 void AddFaceVerticesToMesh(const BlockFaceEnum &face, const BlockTemplate *blockTemplate, const glm::vec3 &origin, Mesh &mesh)
 {
 	std::array<glm::vec3, 4> offsets = BlockUtils::GetVertexOffsetsFromFace(face);
@@ -121,228 +196,984 @@ void AddFaceVerticesToMesh(const BlockFaceEnum &face, const BlockTemplate *block
  * @brief Generates the mesh for this chunk
  */
 void Chunk::GenerateMesh()
+{
+	BuildMeshes();
+	UploadMeshes();
+}
+
+/**
+ * @brief Fills the vertex and index lists of the meshes from the block data without touching the GPU.
+ * Only reads this chunk, so it can run on a worker thread while no other thread uses the chunk.
+ */
+void Chunk::BuildMeshes()
+{
+	ClearMeshData();
+	for (int sectionIndex = 0; sectionIndex < Constants::CHUNK_SECTION_COUNT; ++sectionIndex)
+	{
+		BuildSectionMeshes(sectionIndex);
+	}
+}
+
+/**
+ * @brief Clears the vertex and index lists of the meshes, before they are built again one section at a time
+ */
+void Chunk::ClearMeshData()
 {
 	m_terrainMesh.vertices.clear();
 	m_terrainMesh.indices.clear();
+	m_waterMesh.vertices.clear();
+	m_waterMesh.indices.clear();
+}
+
+/**
+ * @brief Adds the faces of one section to the vertex and index lists of the meshes.
+ * Building every section in order after ClearMeshData() gives the same meshes as BuildMeshes().
+ * @param[in] sectionIndex Index of the section
+ */
+void Chunk::BuildSectionMeshes(const int& sectionIndex)
+{
+	// Empty sections have no faces
+	if (m_sections[sectionIndex] == nullptr)
+	{
+		return;
+	}
 
 	float blockSize = Constants::BLOCK_SIZE;
 
-	glm::vec3 origin(m_chunkIndex.x * Constants::CHUNK_WIDTH * blockSize, 0.0f, m_chunkIndex.z * Constants::CHUNK_DEPTH * blockSize * 1.0f);
-	for (int x = 0; x < Constants::CHUNK_WIDTH; ++x)
+	glm::vec3 origin(m_chunkIndex.x * Constants::CHUNK_WIDTH * blockSize, m_chunkIndex.y * Constants::CHUNK_HEIGHT * blockSize, m_chunkIndex.z * Constants::CHUNK_DEPTH * blockSize * 1.0f);
+	const ChunkSection* section = m_sections[sectionIndex].get();
+	int minY = glm::max(sectionIndex * Constants::SECTION_HEIGHT, m_minHeight);
+	int maxY = glm::min((sectionIndex + 1) * Constants::SECTION_HEIGHT, m_maxHeight);
+
+	// Faces are found four rows at a time by comparing each word of the solid mask with the words of its neighbors.
+	// Blocks outside of the chunk count as not solid.
+	for (int y = minY; y < maxY; ++y)
 	{
-		for (int z = 0; z < Constants::CHUNK_DEPTH; ++z)
+		for (int zGroup = 0; zGroup < Constants::CHUNK_DEPTH / 4; ++zGroup)
 		{
-			for (int y = 0; y < Constants::CHUNK_HEIGHT; ++y)
+			uint64_t solid = GetSolidMaskWord(y, zGroup);
+			if (solid == 0)
+			{
+				continue;
+			}
+
+			const uint64_t LOWEST_X_BITS = 0x0001000100010001ull;
+			const uint64_t HIGHEST_X_BITS = 0x8000800080008000ull;
+			uint64_t topFaces = solid & ~GetSolidMaskWord(y + 1, zGroup);
+			uint64_t bottomFaces = solid & ~GetSolidMaskWord(y - 1, zGroup);
+			uint64_t leftFaces = solid & ~((solid >> 1) & ~HIGHEST_X_BITS);
+			uint64_t rightFaces = solid & ~((solid << 1) & ~LOWEST_X_BITS);
+			uint64_t frontFaces = solid & ~((solid << 16) | (GetSolidMaskWord(y, zGroup - 1) >> 48));
+			uint64_t backFaces = solid & ~((solid >> 16) | (GetSolidMaskWord(y, zGroup + 1) << 48));
+
+			uint64_t visibleBlocks = topFaces | bottomFaces | leftFaces | rightFaces | frontFaces | backFaces;
+			while (visibleBlocks != 0)
 			{
+				int bitIndex = MathUtils::CountTrailingZeros(visibleBlocks);
+				uint64_t bit = 1ull << bitIndex;
+				visibleBlocks &= visibleBlocks - 1;
+
+				int x = bitIndex & 15;
+				int z = (zGroup << 2) | (bitIndex >> 4);
 				glm::vec3 blockOrigin(origin.x + x * blockSize, origin.y + y * blockSize, origin.z + z * blockSize);
-				Block* currentBlock = GetBlockAt(x, y, z);
-				if (currentBlock != nullptr && currentBlock->GetBlockType() != BlockTypeEnum::WATER)
+				BlockTypeEnum currentBlockType = section->GetBlockAt(x, y % Constants::SECTION_HEIGHT, z);
+				const BlockTemplate* blockTemplate = BlockTemplateManager::GetInstance().GetBlockTemplate(currentBlockType);
+
+				if ((topFaces & bit) != 0)
+				{
+					AddFaceVerticesToMesh(BlockFaceEnum::TOP, blockTemplate, blockOrigin, m_terrainMesh);
+				}
+				if ((bottomFaces & bit) != 0)
+				{
+					AddFaceVerticesToMesh(BlockFaceEnum::BOTTOM, blockTemplate, blockOrigin, m_terrainMesh);
+				}
+				if ((leftFaces & bit) != 0)
+				{
+					AddFaceVerticesToMesh(BlockFaceEnum::LEFT, blockTemplate, blockOrigin, m_terrainMesh);
+				}
+				if ((rightFaces & bit) != 0)
 				{
-					const BlockTemplate* blockTemplate = BlockTemplateManager::GetInstance().GetBlockTemplate(currentBlock->GetBlockType());
+					AddFaceVerticesToMesh(BlockFaceEnum::RIGHT, blockTemplate, blockOrigin, m_terrainMesh);
+				}
+				if ((frontFaces & bit) != 0)
+				{
+					AddFaceVerticesToMesh(BlockFaceEnum::FRONT, blockTemplate, blockOrigin, m_terrainMesh);
+				}
+				if ((backFaces & bit) != 0)
+				{
+					AddFaceVerticesToMesh(BlockFaceEnum::BACK, blockTemplate, blockOrigin, m_terrainMesh);
+				}
+			}
+		}
+	}
 
-					// Top face
-					if ((y == Constants::CHUNK_HEIGHT - 1) 
-						|| (GetBlockAt(x, y + 1, z) == nullptr) 
-						|| (GetBlockAt(x, y + 1, z)->GetBlockType() == BlockTypeEnum::WATER))
-					{
-						AddFaceVerticesToMesh(BlockFaceEnum::TOP, blockTemplate, blockOrigin, m_terrainMesh);
-					}
+	// Generate water mesh
+	for (int y = minY; y < maxY; ++y)
+	{
+		for (int zGroup = 0; zGroup < Constants::CHUNK_DEPTH / 4; ++zGroup)
+		{
+			uint64_t liquid = GetLiquidMaskWord(y, zGroup);
+			if (liquid == 0)
+			{
+				continue;
+			}
 
-					// Bottom face
-					if ((y == 0) 
-						|| (GetBlockAt(x, y - 1, z) == nullptr)
-						|| (GetBlockAt(x, y - 1, z)->GetBlockType() == BlockTypeEnum::WATER))
-					{
-						AddFaceVerticesToMesh(BlockFaceEnum::BOTTOM, blockTemplate, blockOrigin, m_terrainMesh);
-					}
-					
-					// Left face
-					if ((x == Constants::CHUNK_WIDTH - 1)
-						|| (GetBlockAt(x + 1, y, z) == nullptr)
-						|| (GetBlockAt(x + 1, y, z)->GetBlockType() == BlockTypeEnum::WATER))
-					{
-						AddFaceVerticesToMesh(BlockFaceEnum::LEFT, blockTemplate, blockOrigin, m_terrainMesh);
-					}
+			// Only the liquid blocks with air above them have a surface
+			uint64_t surfaceBlocks = liquid & ~(GetSolidMaskWord(y + 1, zGroup) | GetLiquidMaskWord(y + 1, zGroup));
+			while (surfaceBlocks != 0)
+			{
+				int bitIndex = MathUtils::CountTrailingZeros(surfaceBlocks);
+				surfaceBlocks &= surfaceBlocks - 1;
 
-					// Right face
-					if ((x == 0)
-						|| (GetBlockAt(x - 1, y, z) == nullptr)
-						|| (GetBlockAt(x - 1, y, z)->GetBlockType() == BlockTypeEnum::WATER))
-					{
-						AddFaceVerticesToMesh(BlockFaceEnum::RIGHT, blockTemplate, blockOrigin, m_terrainMesh);
-					}
+				int x = bitIndex & 15;
+				int z = (zGroup << 2) | (bitIndex >> 4);
 
-					// Front face
-					if ((z == 0) 
-						|| (GetBlockAt(x, y, z - 1) == nullptr)
-						|| (GetBlockAt(x, y, z - 1)->GetBlockType() == BlockTypeEnum::WATER))
-					{
-						AddFaceVerticesToMesh(BlockFaceEnum::FRONT, blockTemplate, blockOrigin, m_terrainMesh);
-					}
+				GLuint indexStart = static_cast<GLuint>(m_waterMesh.vertices.size());
 
-					// Back face
-					if ((z == Constants::CHUNK_DEPTH - 1)
-						|| (GetBlockAt(x, y, z + 1) == nullptr)
-						|| (GetBlockAt(x, y, z + 1)->GetBlockType() == BlockTypeEnum::WATER))
-					{
-						AddFaceVerticesToMesh(BlockFaceEnum::BACK, blockTemplate, blockOrigin, m_terrainMesh);
-					}
-				}
+				float yOffset = -0.1f;
+				m_waterMesh.vertices.emplace_back();
+				m_waterMesh.vertices.back().position = origin + glm::vec3(x * blockSize, (y + 1) * blockSize + yOffset, (z + 1) * blockSize);
+				m_waterMesh.vertices.emplace_back();
+				m_waterMesh.vertices.back().position = origin + glm::vec3((x + 1) * blockSize, (y + 1) * blockSize + yOffset, (z + 1) * blockSize);
+				m_waterMesh.vertices.emplace_back();
+				m_waterMesh.vertices.back().position = origin + glm::vec3((x + 1) * blockSize, (y + 1) * blockSize + yOffset, z * blockSize);
+				m_waterMesh.vertices.emplace_back();
+				m_waterMesh.vertices.back().position = origin + glm::vec3(x * blockSize, (y + 1) * blockSize + yOffset, z * blockSize);
+
+				m_waterMesh.indices.push_back(indexStart);
+				m_waterMesh.indices.push_back(indexStart + 1);
+				m_waterMesh.indices.push_back(indexStart + 2);
+				m_waterMesh.indices.push_back(indexStart + 2);
+				m_waterMesh.indices.push_back(indexStart + 3);
+				m_waterMesh.indices.push_back(indexStart);
 			}
 		}
 	}
+}
+
+/**
+ * @brief Uploads the vertex and index lists built by BuildMeshes() to the GPU. Has to run on the thread with the GL context.
+ */
+void Chunk::UploadMeshes()
+{
+	m_terrainMesh.Upload();
+	m_waterMesh.Upload();
+}
+
+/**
+ * @brief Gets the mesh for the terrain
+ * @return Terrain mesh
+ */
+Mesh* Chunk::GetTerrainMesh()
+{
+	return &m_terrainMesh;
+}
+
+/**
+ * @brief Gets the mesh for water-type blocks
+ * @return Mesh for water-type blocks
+ */
+Mesh* Chunk::GetWaterMesh()
+{
+	return &m_waterMesh;
+}
+
+/**
+ * @brief Gets the block at the specified location
+ * @param[in] x X-coordinate
+ * @param[in] y Y-coordinate
+ * @param[in] z z-coordinate
+ * @return Type of the block at the specified location
+ */
+BlockTypeEnum Chunk::GetBlockAt(int x, int y, int z) const
+{
+	const ChunkSection* section = m_sections[y / Constants::SECTION_HEIGHT].get();
+	if (section == nullptr)
+	{
+		return BlockTypeEnum::AIR;
+	}
+
+	return section->GetBlockAt(x, y % Constants::SECTION_HEIGHT, z);
+}
+
+/**
+ * @brief Checks whether the block at the specified location is solid
+ * @param[in] x X-coordinate
+ * @param[in] y Y-coordinate
+ * @param[in] z z-coordinate
+ * @return True if the block is solid
+ */
+bool Chunk::IsSolidAt(const int& x, const int& y, const int& z) const
+{
+	const ChunkSection* section = m_sections[y / Constants::SECTION_HEIGHT].get();
+	return (section != nullptr) && section->IsSolidAt(x, y % Constants::SECTION_HEIGHT, z);
+}
+
+/**
+ * @brief Checks whether the block at the specified location is a liquid
+ * @param[in] x X-coordinate
+ * @param[in] y Y-coordinate
+ * @param[in] z z-coordinate
+ * @return True if the block is a liquid
+ */
+bool Chunk::IsLiquidAt(const int& x, const int& y, const int& z) const
+{
+	const ChunkSection* section = m_sections[y / Constants::SECTION_HEIGHT].get();
+	return (section != nullptr) && section->IsLiquidAt(x, y % Constants::SECTION_HEIGHT, z);
+}
 
-	if (m_terrainMesh.vao == 0)
+/**
+ * @brief Sets the block at the specified location with the specified block type
+ * @param[in] x X-coordinate
+ * @param[in] y Y-coordinate
+ * @param[in] z z-coordinate
+ * @param[in] type Type of the new block. Can be set to BlockTypeEnum::AIR to remove the block.
+ */
+void Chunk::SetBlockAt(const int& x, const int& y, const int& z, const BlockTypeEnum& type)
+{
+	BlockTypeEnum oldType = GetBlockAt(x, y, z);
+	if (oldType == type)
 	{
-		glGenVertexArrays(1, &m_terrainMesh.vao);
+		return;
 	}
-	glBindVertexArray(m_terrainMesh.vao);
 
-	if (m_terrainMesh.vbo == 0)
+	int sectionIndex = y / Constants::SECTION_HEIGHT;
+	ChunkSection* section = nullptr;
+	if (m_sections[sectionIndex] == nullptr)
 	{
-		glGenBuffers(1, &m_terrainMesh.vbo);
+		m_sections[sectionIndex] = AcquireSection();
+		section = m_sections[sectionIndex].get();
 	}
-	glBindBuffer(GL_ARRAY_BUFFER, m_terrainMesh.vbo);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * m_terrainMesh.vertices.size(), m_terrainMesh.vertices.data(), GL_DYNAMIC_DRAW);
+	else
+	{
+		section = GetWritableSection(sectionIndex);
+	}
+
+	section->SetBlockAt(x, y % Constants::SECTION_HEIGHT, z, type);
+	UpdateHeights(x, y, z, type);
+	++m_version;
 
-	if (m_terrainMesh.ebo == 0)
+	if (m_isRecordingEdits)
 	{
-		glGenBuffers(1, &m_terrainMesh.ebo);
+		m_editJournal.Append(x, y, z, oldType, type);
 	}
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_terrainMesh.ebo);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * m_terrainMesh.indices.size(), m_terrainMesh.indices.data(), GL_DYNAMIC_DRAW);
 
-	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, position)));
+	// Release sections that no longer contain anything
+	if (section->IsEmpty())
+	{
+		ReleaseSection(sectionIndex);
+	}
+}
 
-	glEnableVertexAttribArray(1);
-	glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, color)));
+/**
+ * @brief Gets the height of the specified column, which is the y-coordinate of its topmost non-air block plus one
+ * @param[in] x X-coordinate
+ * @param[in] z Z-coordinate
+ * @return Height of the column. Returns 0 if the column only contains air.
+ */
+int Chunk::GetHeightAt(const int& x, const int& z) const
+{
+	return m_heightMap[z * Constants::CHUNK_WIDTH + x];
+}
 
-	glEnableVertexAttribArray(2);
-	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, uv)));
+/**
+ * @brief Gets a lower bound of the y-coordinate of the lowest non-air block in this chunk.
+ * Every block below this height is air.
+ * @return Lower bound of the lowest non-air block. Returns Constants::CHUNK_HEIGHT if the chunk is empty.
+ */
+int Chunk::GetMinHeight() const
+{
+	return m_minHeight;
+}
 
-	glEnableVertexAttribArray(3);
-	glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, normal)));
+/**
+ * @brief Gets the height of the tallest column in this chunk. Every block at or above this height is air.
+ * @return Height of the tallest column
+ */
+int Chunk::GetMaxHeight() const
+{
+	return m_maxHeight;
+}
 
-	glBindVertexArray(0);
+/**
+ * @brief Gets the section at the specified section index
+ * @param[in] sectionIndex Section index
+ * @return Section at the specified index. Returns nullptr if the section only contains air.
+ */
+const ChunkSection* Chunk::GetSection(const int& sectionIndex) const
+{
+	return m_sections[sectionIndex].get();
+}
 
-	// Generate water mesh
-	for (int x = 0; x < Constants::CHUNK_WIDTH; ++x)
+/**
+ * @brief Gets the number of sections that contain at least one non-air block
+ * @return Number of allocated sections
+ */
+int Chunk::GetAllocatedSectionCount() const
+{
+	int ret = 0;
+	for (size_t i = 0; i < m_sections.size(); ++i)
 	{
-		for (int z = 0; z < Constants::CHUNK_DEPTH; ++z)
+		if (m_sections[i] != nullptr)
 		{
-			for (int y = 0; y < Constants::CHUNK_HEIGHT; ++y)
+			++ret;
+		}
+	}
+	return ret;
+}
+
+/**
+ * @brief Compacts the block storage of every section.
+ * Should be called after bulk modifications such as world generation.
+ */
+void Chunk::CompactSections()
+{
+	for (size_t i = 0; i < m_sections.size(); ++i)
+	{
+		// Compacting repacks the storage in place, so shared sections are left alone
+		if ((m_sections[i] != nullptr) && (m_sections[i].use_count() == 1) && !m_sections[i]->IsShared())
+		{
+			m_sections[i]->Compact();
+		}
+	}
+}
+
+/**
+ * @brief Replaces sections with identical sections already used by other chunks.
+ * Should be called after CompactSections(), since only sections packed the same way can be matched.
+ * @param[in] sharedSections Table of sections that can be shared
+ */
+void Chunk::ShareSections(SharedSectionTable& sharedSections)
+{
+	for (size_t i = 0; i < m_sections.size(); ++i)
+	{
+		// Replaced sections are freed instead of being kept as spares, since that is the memory being saved
+		if (m_sections[i] != nullptr)
+		{
+			m_sections[i] = sharedSections.Share(m_sections[i]);
+		}
+	}
+}
+
+/**
+ * @brief Gets the number of bytes used by the block data of this chunk.
+ * Sections shared with other chunks or snapshots are split evenly between their users.
+ * @return Block data memory usage in bytes
+ */
+size_t Chunk::GetBlockMemoryUsage() const
+{
+	size_t ret = sizeof(m_sections) + m_compressedBlockData.capacity();
+	for (size_t i = 0; i < m_sections.size(); ++i)
+	{
+		if (m_sections[i] != nullptr)
+		{
+			ret += m_sections[i]->GetMemoryUsage() / m_sections[i].use_count();
+		}
+	}
+	return ret;
+}
+
+/**
+ * @brief Gets the number of bytes used by this chunk, broken down into block data, meshes and bookkeeping
+ * @return Memory usage
+ */
+MemoryUsage Chunk::GetMemoryUsage() const
+{
+	MemoryUsage ret;
+
+	ret.blockStorageBytes = GetBlockMemoryUsage();
+	for (size_t i = 0; i < m_spareSections.size(); ++i)
+	{
+		ret.blockStorageBytes += m_spareSections[i]->GetMemoryUsage();
+	}
+
+	ret.cpuMeshBytes = m_terrainMesh.GetCPUMemoryUsage() + m_waterMesh.GetCPUMemoryUsage();
+	ret.gpuBufferBytes = m_terrainMesh.GetGPUMemoryUsage() + m_waterMesh.GetGPUMemoryUsage();
+
+	// The section table is already counted as block storage
+	ret.bookkeepingBytes = sizeof(Chunk) - sizeof(m_sections)
+		+ m_spareSections.capacity() * sizeof(std::shared_ptr<ChunkSection>)
+		+ m_editJournal.GetMemoryUsage();
+
+	return ret;
+}
+
+/**
+ * @brief Deletes the GPU buffers and frees the vertex lists of the meshes.
+ * GenerateMesh() has to be called before the chunk is drawn again.
+ */
+void Chunk::ReleaseMeshes()
+{
+	m_terrainMesh.Release();
+	m_waterMesh.Release();
+}
+
+/**
+ * @brief Hands the GPU buffers of the meshes over to the deletion queue, so that the chunk
+ * can be deleted on a thread without a GL context
+ * @param[in] deletionQueue Queue that deletes the buffers on the render thread
+ */
+void Chunk::DeferMeshBufferDeletion(GLDeletionQueue& deletionQueue)
+{
+	m_terrainMesh.DeferBufferDeletion(deletionQueue);
+	m_waterMesh.DeferBufferDeletion(deletionQueue);
+}
+
+/**
+ * @brief Checks whether the meshes have been generated and uploaded
+ * @return True if the meshes are ready to be drawn
+ */
+bool Chunk::HasMeshes() const
+{
+	return m_terrainMesh.IsUploaded() && m_waterMesh.IsUploaded();
+}
+
+/**
+ * @brief Run-length encodes the block data into a compact buffer and frees the sections.
+ * Blocks cannot be accessed until DecompressBlockData() is called.
+ */
+void Chunk::CompressBlockData()
+{
+	if (m_isBlockDataCompressed)
+	{
+		return;
+	}
+
+	// Layout: bit mask of the allocated sections (4 bytes), followed by each allocated section from the bottom up.
+	// Terrain is made of horizontal layers, so the runs are long.
+	uint32_t sectionMask = 0;
+	for (size_t i = 0; i < m_sections.size(); ++i)
+	{
+		if (m_sections[i] != nullptr)
+		{
+			sectionMask |= (1u << i);
+		}
+	}
+
+	m_compressedBlockData.resize(sizeof(sectionMask));
+	memcpy(m_compressedBlockData.data(), &sectionMask, sizeof(sectionMask));
+	for (size_t i = 0; i < m_sections.size(); ++i)
+	{
+		if (m_sections[i] != nullptr)
+		{
+			m_sections[i]->EncodeRuns(m_compressedBlockData);
+		}
+	}
+	std::vector<uint8_t>(m_compressedBlockData).swap(m_compressedBlockData);
+
+	for (size_t i = 0; i < m_sections.size(); ++i)
+	{
+		m_sections[i] = nullptr;
+	}
+	std::vector<std::shared_ptr<ChunkSection>>().swap(m_spareSections);
+
+	m_isBlockDataCompressed = true;
+}
+
+/**
+ * @brief Restores the sections from the compressed block data
+ */
+void Chunk::DecompressBlockData()
+{
+	if (!m_isBlockDataCompressed)
+	{
+		return;
+	}
+
+	// The blocks themselves do not change, so the version and the height map are kept
+	uint32_t sectionMask = 0;
+	memcpy(&sectionMask, m_compressedBlockData.data(), sizeof(sectionMask));
+	size_t offset = sizeof(sectionMask);
+	for (int i = 0; i < Constants::CHUNK_SECTION_COUNT; ++i)
+	{
+		if ((sectionMask & (1u << i)) != 0)
+		{
+			m_sections[i] = AcquireSection();
+			offset += m_sections[i]->DecodeRuns(m_compressedBlockData.data() + offset, m_compressedBlockData.size() - offset);
+		}
+	}
+
+	m_isBlockDataCompressed = false;
+	std::vector<uint8_t>().swap(m_compressedBlockData);
+}
+
+/**
+ * @brief Releases the meshes and compresses the block data, keeping the chunk in memory
+ * so that it can be brought back without generating its terrain again
+ */
+void Chunk::Hibernate()
+{
+	ReleaseMeshes();
+	CompressBlockData();
+}
+
+/**
+ * @brief Checks whether the chunk is hibernated
+ * @return True if the block data is compressed and the meshes are released
+ */
+bool Chunk::IsHibernated() const
+{
+	return m_isBlockDataCompressed && !m_terrainMesh.IsUploaded() && !m_waterMesh.IsUploaded();
+}
+
+/**
+ * @brief Gets the current stage of the lifecycle of this chunk
+ * @return Chunk state
+ */
+ChunkStateEnum Chunk::GetState() const
+{
+	return m_state;
+}
+
+/**
+ * @brief Moves the chunk to another stage of its lifecycle.
+ * Entering ChunkStateEnum::UNLOADING cancels the cancellation token,
+ * and leaving it gives the chunk a new token.
+ * @param[in] state New state
+ */
+void Chunk::SetState(const ChunkStateEnum& state)
+{
+	if ((state == ChunkStateEnum::UNLOADING) && (m_state != ChunkStateEnum::UNLOADING))
+	{
+		m_cancellationToken.Cancel();
+	}
+	else if ((state != ChunkStateEnum::UNLOADING) && (m_state == ChunkStateEnum::UNLOADING))
+	{
+		m_cancellationToken = CancellationToken();
+	}
+
+	m_state = state;
+}
+
+/**
+ * @brief Moves the chunk to the next stage of its lifecycle, unless it left the expected stage in the meantime.
+ * Can be called from the job system threads, even while the main thread starts unloading the chunk.
+ * @param[in] expectedState Stage the chunk should be in
+ * @param[in] state New state
+ * @return True if the state was changed, false if the chunk was not in the expected stage
+ */
+bool Chunk::AdvanceState(const ChunkStateEnum& expectedState, const ChunkStateEnum& state)
+{
+	// A chunk that started unloading keeps that state, along with its cancelled token
+	ChunkStateEnum currentState = expectedState;
+	return m_state.compare_exchange_strong(currentState, state);
+}
+
+/**
+ * @brief Gets the token that work for this chunk should check to find out whether it is still needed
+ * @return Copy of the cancellation token of the chunk
+ */
+CancellationToken Chunk::GetCancellationToken() const
+{
+	return m_cancellationToken;
+}
+
+/**
+ * @brief Checks whether the block data is compressed
+ * @return True if the block data is compressed
+ */
+bool Chunk::IsBlockDataCompressed() const
+{
+	return m_isBlockDataCompressed;
+}
+
+/**
+ * @brief Gets the version of the block data, which is incremented whenever a block changes or the chunk gets reset
+ * @return Chunk version
+ */
+uint64_t Chunk::GetVersion() const
+{
+	return m_version;
+}
+
+/**
+ * @brief Creates an immutable snapshot of the block data that can be read from other threads.
+ * Sections are shared with the snapshot instead of being copied.
+ * @return Snapshot of the current block data
+ */
+ChunkSnapshot Chunk::CreateSnapshot() const
+{
+	ChunkSnapshot::SectionArray sections;
+	for (size_t i = 0; i < m_sections.size(); ++i)
+	{
+		sections[i] = m_sections[i];
+	}
+
+	return ChunkSnapshot(m_chunkIndex, m_version, sections, m_heightMap, m_minHeight, m_maxHeight);
+}
+
+/**
+ * @brief Checks whether the snapshot still matches the current block data of this chunk.
+ * Results computed from a stale snapshot should be discarded.
+ * @param[in] snapshot Snapshot to check
+ * @return Returns true if the snapshot was taken from this chunk at its current version
+ */
+bool Chunk::IsSnapshotCurrent(const ChunkSnapshot& snapshot) const
+{
+	return (snapshot.GetChunkIndices() == m_chunkIndex) && (snapshot.GetVersion() == m_version);
+}
+
+/**
+ * @brief Checks whether the block data changed since it was last saved or generated
+ * @return True if the block data has changes that would be lost when the chunk is unloaded
+ */
+bool Chunk::HasUnsavedChanges() const
+{
+	return m_version != m_savedVersion;
+}
+
+/**
+ * @brief Marks the current block data as persisted, either because it was saved
+ * or because it can be generated again from the world generation parameters
+ */
+void Chunk::MarkSaved()
+{
+	m_savedVersion = m_version;
+}
+
+/**
+ * @brief Marks the block data as not persisted, so that the chunk is saved again.
+ * Used when writing the saved data failed.
+ */
+void Chunk::MarkUnsaved()
+{
+	m_savedVersion = m_version - 1;
+}
+
+/**
+ * @brief Appends the block data of this chunk to the buffer
+ * @param[out] buffer Buffer to append to
+ */
+void Chunk::Serialize(std::vector<uint8_t>& buffer) const
+{
+	if (m_isBlockDataCompressed)
+	{
+		// The compressed data starts with the same section mask, so only the sections have to be converted
+		uint32_t compressedSectionMask = 0;
+		memcpy(&compressedSectionMask, m_compressedBlockData.data(), sizeof(compressedSectionMask));
+		buffer.insert(buffer.end(), m_compressedBlockData.begin(), m_compressedBlockData.begin() + sizeof(compressedSectionMask));
+
+		ChunkSection section;
+		size_t offset = sizeof(compressedSectionMask);
+		for (int i = 0; i < Constants::CHUNK_SECTION_COUNT; ++i)
+		{
+			if ((compressedSectionMask & (1u << i)) != 0)
 			{
-				Block* currentBlock = GetBlockAt(x, y, z);
-				if ((currentBlock != nullptr) && (currentBlock->GetBlockType() == BlockTypeEnum::WATER))
-				{
-					if ((y == Constants::CHUNK_HEIGHT - 1) || (GetBlockAt(x, y + 1, z) == nullptr))
-					{
-						GLuint indexStart = static_cast<GLuint>(m_waterMesh.vertices.size());
-
-						float yOffset = -0.1f;
-						m_waterMesh.vertices.emplace_back();
-						m_waterMesh.vertices.back().position = origin + glm::vec3(x * blockSize, (y + 1) * blockSize + yOffset, (z + 1) * blockSize);
-						m_waterMesh.vertices.emplace_back();
-						m_waterMesh.vertices.back().position = origin + glm::vec3((x + 1) * blockSize, (y + 1) * blockSize + yOffset, (z + 1) * blockSize);
-						m_waterMesh.vertices.emplace_back();
-						m_waterMesh.vertices.back().position = origin + glm::vec3((x + 1) * blockSize, (y + 1) * blockSize + yOffset, z * blockSize);
-						m_waterMesh.vertices.emplace_back();
-						m_waterMesh.vertices.back().position = origin + glm::vec3(x * blockSize, (y + 1) * blockSize + yOffset, z * blockSize);
-
-						m_waterMesh.indices.push_back(indexStart);
-						m_waterMesh.indices.push_back(indexStart + 1);
-						m_waterMesh.indices.push_back(indexStart + 2);
-						m_waterMesh.indices.push_back(indexStart + 2);
-						m_waterMesh.indices.push_back(indexStart + 3);
-						m_waterMesh.indices.push_back(indexStart);
-					}
-				}
+				offset += section.DecodeRuns(m_compressedBlockData.data() + offset, m_compressedBlockData.size() - offset);
+				section.Serialize(buffer);
 			}
 		}
+		return;
 	}
 
-	if (m_waterMesh.vao == 0)
+	// Layout: bit mask of the allocated sections (4 bytes), followed by each allocated section from the bottom up
+	uint32_t sectionMask = 0;
+	for (size_t i = 0; i < m_sections.size(); ++i)
 	{
-		glGenVertexArrays(1, &m_waterMesh.vao);
+		if (m_sections[i] != nullptr)
+		{
+			sectionMask |= (1u << i);
+		}
 	}
-	glBindVertexArray(m_waterMesh.vao);
 
-	if (m_waterMesh.vbo == 0)
+	size_t offset = buffer.size();
+	buffer.resize(offset + sizeof(sectionMask));
+	memcpy(&buffer[offset], &sectionMask, sizeof(sectionMask));
+
+	for (size_t i = 0; i < m_sections.size(); ++i)
 	{
-		glGenBuffers(1, &m_waterMesh.vbo);
+		if (m_sections[i] != nullptr)
+		{
+			m_sections[i]->Serialize(buffer);
+		}
 	}
-	glBindBuffer(GL_ARRAY_BUFFER, m_waterMesh.vbo);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * m_waterMesh.vertices.size(), m_waterMesh.vertices.data(), GL_DYNAMIC_DRAW);
+}
 
-	if (m_waterMesh.ebo == 0)
+/**
+ * @brief Loads serialized block data into this chunk, which should be empty.
+ * The data is validated, and the chunk is left empty if it is malformed.
+ * @param[in] data Serialized data
+ * @param[in] size Number of bytes available in the data
+ * @return True if the data was loaded, false if it is malformed
+ */
+bool Chunk::Deserialize(const uint8_t* data, const size_t& size)
+{
+	uint32_t sectionMask = 0;
+	if (size < sizeof(sectionMask))
 	{
-		glGenBuffers(1, &m_waterMesh.ebo);
+		return false;
 	}
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_waterMesh.ebo);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * m_waterMesh.indices.size(), m_waterMesh.indices.data(), GL_DYNAMIC_DRAW);
+	memcpy(&sectionMask, data, sizeof(sectionMask));
+	size_t offset = sizeof(sectionMask);
 
-	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, position)));
+	bool isValid = (sectionMask >> (Constants::CHUNK_SECTION_COUNT - 1) >> 1) == 0;
+	for (int i = 0; isValid && (i < Constants::CHUNK_SECTION_COUNT); ++i)
+	{
+		if ((sectionMask & (1u << i)) == 0)
+		{
+			continue;
+		}
 
-	glEnableVertexAttribArray(1);
-	glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, color)));
+		m_sections[i] = AcquireSection();
+		size_t numBytesRead = m_sections[i]->Deserialize(data + offset, size - offset);
+		isValid = numBytesRead > 0;
+		offset += numBytesRead;
 
-	glEnableVertexAttribArray(2);
-	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, uv)));
+		if (m_sections[i]->IsEmpty())
+		{
+			ReleaseSection(i);
+		}
+	}
 
-	glEnableVertexAttribArray(3);
-	glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, normal)));
+	if (!isValid)
+	{
+		for (size_t i = 0; i < m_sections.size(); ++i)
+		{
+			if (m_sections[i] != nullptr)
+			{
+				ReleaseSection(static_cast<int>(i));
+			}
+		}
+	}
 
-	glBindVertexArray(0);
+	RecalculateHeights();
+	++m_version;
+	return isValid;
 }
 
 /**
- * @brief Gets the mesh for the terrain
- * @return Terrain mesh
+ * @brief Clears the edit journal and starts recording block changes in it.
+ * Should be called right after the terrain of this chunk is generated.
  */
-Mesh* Chunk::GetTerrainMesh()
+void Chunk::StartRecordingEdits()
 {
-	return &m_terrainMesh;
+	m_editJournal.Clear();
+	m_isRecordingEdits = true;
 }
 
 /**
- * @brief Gets the mesh for water-type blocks
- * @return Mesh for water-type blocks
+ * @brief Checks whether block changes are recorded in the edit journal.
+ * Chunks loaded from complete block data do not record edits.
+ * @return True if block changes are recorded
  */
-Mesh* Chunk::GetWaterMesh()
+bool Chunk::IsRecordingEdits() const
 {
-	return &m_waterMesh;
+	return m_isRecordingEdits;
 }
 
 /**
- * @brief Gets the block at the specified location
- * @param[in] x X-coordinate
- * @param[in] y Y-coordinate
- * @param[in] z z-coordinate
- * @return Block data of the block at the specified location
+ * @brief Gets the journal of block changes made since the terrain was generated
+ * @return Edit journal
+ */
+const ChunkEditJournal& Chunk::GetEditJournal() const
+{
+	return m_editJournal;
+}
+
+/**
+ * @brief Compacts the edit journal
+ */
+void Chunk::CompactEditJournal()
+{
+	m_editJournal.Compact();
+}
+
+/**
+ * @brief Gets a word of the solid block mask
+ * @param[in] y Y-coordinate. Returns 0 if it is outside of the chunk.
+ * @param[in] zGroup Z-coordinate divided by 4. Returns 0 if it is outside of the chunk.
+ * @return Solid block bits of four rows along the x-axis, laid out like in ChunkSection
+ */
+uint64_t Chunk::GetSolidMaskWord(const int& y, const int& zGroup) const
+{
+	if ((y < 0) || (y >= Constants::CHUNK_HEIGHT) || (zGroup < 0) || (zGroup >= Constants::CHUNK_DEPTH / 4))
+	{
+		return 0;
+	}
+
+	const ChunkSection* section = m_sections[y / Constants::SECTION_HEIGHT].get();
+	if (section == nullptr)
+	{
+		return 0;
+	}
+
+	return section->GetSolidMaskWord(((y % Constants::SECTION_HEIGHT) << 2) | zGroup);
+}
+
+/**
+ * @brief Gets a word of the liquid block mask
+ * @param[in] y Y-coordinate. Returns 0 if it is outside of the chunk.
+ * @param[in] zGroup Z-coordinate divided by 4. Returns 0 if it is outside of the chunk.
+ * @return Liquid block bits of four rows along the x-axis, laid out like in ChunkSection
+ */
+uint64_t Chunk::GetLiquidMaskWord(const int& y, const int& zGroup) const
+{
+	if ((y < 0) || (y >= Constants::CHUNK_HEIGHT) || (zGroup < 0) || (zGroup >= Constants::CHUNK_DEPTH / 4))
+	{
+		return 0;
+	}
+
+	const ChunkSection* section = m_sections[y / Constants::SECTION_HEIGHT].get();
+	if (section == nullptr)
+	{
+		return 0;
+	}
+
+	return section->GetLiquidMaskWord(((y % Constants::SECTION_HEIGHT) << 2) | zGroup);
+}
+
+/**
+ * @brief Gets an empty section, reusing a spare section if there is one
+ * @return Empty section
+ */
+std::shared_ptr<ChunkSection> Chunk::AcquireSection()
+{
+	if (m_spareSections.empty())
+	{
+		return std::make_shared<ChunkSection>();
+	}
+
+	std::shared_ptr<ChunkSection> section = m_spareSections.back();
+	m_spareSections.pop_back();
+	return section;
+}
+
+/**
+ * @brief Removes the section at the specified index, keeping it as a spare section
+ * if no snapshot shares it and it is not registered in the shared section table
+ * @param[in] sectionIndex Section index
  */
-Block* Chunk::GetBlockAt(int x, int y, int z)
+void Chunk::ReleaseSection(const int& sectionIndex)
 {
-	int index = (z * Constants::CHUNK_WIDTH + x) * Constants::CHUNK_HEIGHT + y;
-	return m_blocks[index];
+	std::shared_ptr<ChunkSection> section;
+	section.swap(m_sections[sectionIndex]);
+
+	// A section still read through a snapshot gets freed along with the last snapshot instead.
+	// A registered section is dropped as well, since the main thread can still find it through the table
+	// while a worker thread refills the spare sections.
+	if ((section.use_count() == 1) && !section->IsShared())
+	{
+		std::atomic_thread_fence(std::memory_order_acquire);
+		section->Clear();
+		m_spareSections.push_back(section);
+	}
+}
+
+/**
+ * @brief Gets the section at the specified index for modification,
+ * copying it first if it is shared with a snapshot or registered in the shared section table
+ * @param[in] sectionIndex Section index
+ * @return Section that is only referenced by this chunk
+ */
+ChunkSection* Chunk::GetWritableSection(const int& sectionIndex)
+{
+	// The table can hand a registered section to another chunk at any time, even while this chunk is its only user
+	std::shared_ptr<ChunkSection>& section = m_sections[sectionIndex];
+	if ((section.use_count() != 1) || section->IsShared())
+	{
+		section = std::make_shared<ChunkSection>(*section);
+	}
+	else
+	{
+		// Make sure reads done through snapshots that were just released happen before the writes
+		std::atomic_thread_fence(std::memory_order_acquire);
+	}
+
+	return section.get();
 }
 
 /**
- * @brief Sets the block at the specified location with the specified block
+ * @brief Updates the height map and height bounds after a block was set
  * @param[in] x X-coordinate
  * @param[in] y Y-coordinate
- * @param[in] z z-coordinate
- * @param[in] block Data for the new block. Can be set to nullptr if it's an air block.
+ * @param[in] z Z-coordinate
+ * @param[in] type Type of the new block
  */
-void Chunk::SetBlockAt(const int& x, const int& y, const int& z, Block* block)
+void Chunk::UpdateHeights(const int& x, const int& y, const int& z, const BlockTypeEnum& type)
 {
-	Block* existingBlock = GetBlockAt(x, y, z);
-	if (existingBlock != nullptr)
+	uint16_t& columnHeight = m_heightMap[z * Constants::CHUNK_WIDTH + x];
+
+	if (type != BlockTypeEnum::AIR)
 	{
-		delete existingBlock;
+		if (y + 1 > columnHeight)
+		{
+			columnHeight = static_cast<uint16_t>(y + 1);
+			m_maxHeight = glm::max(m_maxHeight, y + 1);
+		}
+		m_minHeight = glm::min(m_minHeight, y);
+		return;
 	}
 
-	int index = (z * Constants::CHUNK_WIDTH + x) * Constants::CHUNK_HEIGHT + y;
-	m_blocks[index] = block;
+	// Only removing the topmost block of a column changes its height
+	if (y + 1 != columnHeight)
+	{
+		return;
+	}
+
+	int newHeight = 0;
+	for (int currentY = y - 1; currentY >= 0; --currentY)
+	{
+		if (m_sections[currentY / Constants::SECTION_HEIGHT] == nullptr)
+		{
+			// Jump to the top of the section below
+			currentY -= currentY % Constants::SECTION_HEIGHT;
+			continue;
+		}
+
+		if (GetBlockAt(x, currentY, z) != BlockTypeEnum::AIR)
+		{
+			newHeight = currentY + 1;
+			break;
+		}
+	}
+
+	int oldHeight = columnHeight;
+	columnHeight = static_cast<uint16_t>(newHeight);
+
+	if (oldHeight == m_maxHeight)
+	{
+		m_maxHeight = 0;
+		for (size_t i = 0; i < m_heightMap.size(); ++i)
+		{
+			m_maxHeight = glm::max(m_maxHeight, static_cast<int>(m_heightMap[i]));
+		}
+	}
+}
+
+/**
+ * @brief Recomputes the height map and height bounds from the block data
+ */
+void Chunk::RecalculateHeights()
+{
+	m_heightMap.fill(0);
+	m_minHeight = Constants::CHUNK_HEIGHT;
+	m_maxHeight = 0;
+
+	for (int sectionIndex = Constants::CHUNK_SECTION_COUNT - 1; sectionIndex >= 0; --sectionIndex)
+	{
+		if (m_sections[sectionIndex] == nullptr)
+		{
+			continue;
+		}
+
+		// Sections are visited from the top down, so the first non-air block found in a column is its topmost one
+		int sectionMinY = sectionIndex * Constants::SECTION_HEIGHT;
+		for (int z = 0; z < Constants::CHUNK_DEPTH; ++z)
+		{
+			for (int x = 0; x < Constants::CHUNK_WIDTH; ++x)
+			{
+				uint16_t& columnHeight = m_heightMap[z * Constants::CHUNK_WIDTH + x];
+				for (int y = sectionMinY + Constants::SECTION_HEIGHT - 1; (columnHeight == 0) && (y >= sectionMinY); --y)
+				{
+					if (GetBlockAt(x, y, z) != BlockTypeEnum::AIR)
+					{
+						columnHeight = static_cast<uint16_t>(y + 1);
+						m_maxHeight = glm::max(m_maxHeight, y + 1);
+					}
+				}
+			}
+		}
+
+		m_minHeight = sectionMinY;
+	}
 }
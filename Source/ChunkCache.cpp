@@ -0,0 +1,315 @@
+#include "ChunkCache.hpp"
+
+#include "Utils/CoordinateUtils.hpp"
+
+/**
+ * @brief Constructor
+ * @param[in] budget Maximum number of bytes the cached chunks can use
+ */
+ChunkCache::ChunkCache(const size_t& budget)
+	: m_chunks()
+	, m_chunkMap()
+	, m_budget(budget)
+	, m_residentBytes(0)
+	, m_numHits(0)
+	, m_numMisses(0)
+	, m_numHibernations(0)
+	, m_numBytesBeforeHibernation(0)
+	, m_numBytesAfterHibernation(0)
+	, m_numRehydrations(0)
+	, m_totalRehydrationTime(0.0)
+	, m_maxRehydrationTime(0.0f)
+{
+}
+
+/**
+ * @brief Destructor. Deletes every chunk that is still in the cache.
+ */
+ChunkCache::~ChunkCache()
+{
+	std::vector<Chunk*> removedChunks;
+	Clear(removedChunks);
+	for (size_t i = 0; i < removedChunks.size(); ++i)
+	{
+		delete removedChunks[i];
+	}
+}
+
+/**
+ * @brief Adds the chunk to the cache as the most recently used chunk.
+ * The chunk should already be removed from the world.
+ * @param[in] chunk Chunk to add
+ */
+void ChunkCache::Insert(Chunk* chunk)
+{
+	m_chunks.push_front(chunk);
+
+	Entry entry;
+	entry.position = m_chunks.begin();
+	entry.chargedBytes = chunk->GetMemoryUsage().GetTotal();
+	m_chunkMap[CoordinateUtils::PackChunkIndex(chunk->GetChunkIndexX(), chunk->GetChunkIndexY(), chunk->GetChunkIndexZ())] = entry;
+	m_residentBytes += entry.chargedBytes;
+}
+
+/**
+ * @brief Removes the chunk at the provided location indices from the cache
+ * @param[in] chunkIndexX Chunk x-index
+ * @param[in] chunkIndexY Chunk y-index
+ * @param[in] chunkIndexZ Chunk z-index
+ * @return Chunk at the provided location. Returns nullptr if the chunk is not in the cache.
+ */
+Chunk* ChunkCache::Take(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ)
+{
+	std::unordered_map<uint64_t, Entry>::iterator it = m_chunkMap.find(CoordinateUtils::PackChunkIndex(chunkIndexX, chunkIndexY, chunkIndexZ));
+	if (it == m_chunkMap.end())
+	{
+		++m_numMisses;
+		return nullptr;
+	}
+
+	++m_numHits;
+	Chunk* chunk = *it->second.position;
+	m_residentBytes -= it->second.chargedBytes;
+	m_chunks.erase(it->second.position);
+	m_chunkMap.erase(it);
+	return chunk;
+}
+
+/**
+ * @brief Gets the chunk at the provided location indices without removing it from the cache or counting a hit or a miss
+ * @param[in] chunkIndexX Chunk x-index
+ * @param[in] chunkIndexY Chunk y-index
+ * @param[in] chunkIndexZ Chunk z-index
+ * @return Chunk at the provided location. Returns nullptr if the chunk is not in the cache.
+ */
+Chunk* ChunkCache::Find(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ) const
+{
+	std::unordered_map<uint64_t, Entry>::const_iterator it = m_chunkMap.find(CoordinateUtils::PackChunkIndex(chunkIndexX, chunkIndexY, chunkIndexZ));
+	if (it == m_chunkMap.end())
+	{
+		return nullptr;
+	}
+
+	return *it->second.position;
+}
+
+/**
+ * @brief Shrinks the least recently used chunks until the cache fits in its budget
+ * @param[out] evictedChunks Chunks that had to be removed from the cache. The caller takes ownership of these chunks.
+ */
+void ChunkCache::EnforceBudget(std::vector<Chunk*>& evictedChunks)
+{
+	// Meshes are the cheapest to restore, so they are dropped first
+	for (std::list<Chunk*>::reverse_iterator it = m_chunks.rbegin(); (it != m_chunks.rend()) && (m_residentBytes > m_budget); ++it)
+	{
+		Chunk* chunk = *it;
+		if (chunk->HasMeshes())
+		{
+			chunk->ReleaseMeshes();
+			UpdateChargedBytes(chunk);
+		}
+	}
+
+	for (std::list<Chunk*>::reverse_iterator it = m_chunks.rbegin(); (it != m_chunks.rend()) && (m_residentBytes > m_budget); ++it)
+	{
+		Chunk* chunk = *it;
+		if (!chunk->IsHibernated())
+		{
+			m_numBytesBeforeHibernation += chunk->GetBlockMemoryUsage();
+			chunk->Hibernate();
+			m_numBytesAfterHibernation += chunk->GetBlockMemoryUsage();
+			++m_numHibernations;
+			UpdateChargedBytes(chunk);
+		}
+	}
+
+	while (!m_chunks.empty() && (m_residentBytes > m_budget))
+	{
+		Chunk* chunk = m_chunks.back();
+		std::unordered_map<uint64_t, Entry>::iterator entryIt = m_chunkMap.find(CoordinateUtils::PackChunkIndex(chunk->GetChunkIndexX(), chunk->GetChunkIndexY(), chunk->GetChunkIndexZ()));
+		m_residentBytes -= entryIt->second.chargedBytes;
+		m_chunkMap.erase(entryIt);
+		m_chunks.pop_back();
+		evictedChunks.push_back(chunk);
+	}
+}
+
+/**
+ * @brief Removes every chunk from the cache
+ * @param[out] removedChunks Chunks that were in the cache. The caller takes ownership of these chunks.
+ */
+void ChunkCache::Clear(std::vector<Chunk*>& removedChunks)
+{
+	removedChunks.insert(removedChunks.end(), m_chunks.begin(), m_chunks.end());
+	m_chunks.clear();
+	m_chunkMap.clear();
+	m_residentBytes = 0;
+}
+
+/**
+ * @brief Gets the cached chunks
+ * @return Cached chunks, from the most recently used to the least recently used
+ */
+const std::list<Chunk*>& ChunkCache::GetChunks() const
+{
+	return m_chunks;
+}
+
+/**
+ * @brief Sets the maximum number of bytes the cached chunks can use.
+ * Takes effect on the next call to EnforceBudget().
+ * @param[in] budget Budget in bytes
+ */
+void ChunkCache::SetBudget(const size_t& budget)
+{
+	m_budget = budget;
+}
+
+/**
+ * @brief Gets the maximum number of bytes the cached chunks can use
+ * @return Budget in bytes
+ */
+size_t ChunkCache::GetBudget() const
+{
+	return m_budget;
+}
+
+/**
+ * @brief Gets the number of bytes used by the cached chunks
+ * @return Resident bytes
+ */
+size_t ChunkCache::GetResidentBytes() const
+{
+	return m_residentBytes;
+}
+
+/**
+ * @brief Gets the number of chunks in the cache
+ * @return Number of cached chunks
+ */
+size_t ChunkCache::GetCachedChunkCount() const
+{
+	return m_chunks.size();
+}
+
+/**
+ * @brief Gets the number of lookups that found the chunk in the cache
+ * @return Number of cache hits
+ */
+uint64_t ChunkCache::GetHitCount() const
+{
+	return m_numHits;
+}
+
+/**
+ * @brief Gets the number of lookups that did not find the chunk in the cache
+ * @return Number of cache misses
+ */
+uint64_t ChunkCache::GetMissCount() const
+{
+	return m_numMisses;
+}
+
+/**
+ * @brief Gets the fraction of lookups that found the chunk in the cache
+ * @return Hit rate between 0 and 1. Returns 0 if there were no lookups.
+ */
+float ChunkCache::GetHitRate() const
+{
+	uint64_t numLookups = m_numHits + m_numMisses;
+	if (numLookups == 0)
+	{
+		return 0.0f;
+	}
+
+	return static_cast<float>(m_numHits) / numLookups;
+}
+
+/**
+ * @brief Gets the number of cached chunks that are hibernated
+ * @return Number of hibernated chunks
+ */
+size_t ChunkCache::GetHibernatedChunkCount() const
+{
+	size_t ret = 0;
+	for (std::list<Chunk*>::const_iterator it = m_chunks.begin(); it != m_chunks.end(); ++it)
+	{
+		if ((*it)->IsHibernated())
+		{
+			++ret;
+		}
+	}
+	return ret;
+}
+
+/**
+ * @brief Gets how much hibernation shrinks the block data of a chunk on average
+ * @return Block data size before hibernation divided by the size after. Returns 0 if no chunk was hibernated yet.
+ */
+float ChunkCache::GetCompressionRatio() const
+{
+	if (m_numBytesAfterHibernation == 0)
+	{
+		return 0.0f;
+	}
+
+	return static_cast<float>(static_cast<double>(m_numBytesBeforeHibernation) / m_numBytesAfterHibernation);
+}
+
+/**
+ * @brief Records the time it took to bring back a chunk that had been shrunk in the cache
+ * @param[in] milliseconds Time spent decompressing and meshing the chunk
+ */
+void ChunkCache::RecordRehydration(const float& milliseconds)
+{
+	++m_numRehydrations;
+	m_totalRehydrationTime += milliseconds;
+	if (milliseconds > m_maxRehydrationTime)
+	{
+		m_maxRehydrationTime = milliseconds;
+	}
+}
+
+/**
+ * @brief Gets the number of chunks that had to be decompressed or meshed again when they were taken out of the cache
+ * @return Number of rehydrated chunks
+ */
+uint64_t ChunkCache::GetRehydrationCount() const
+{
+	return m_numRehydrations;
+}
+
+/**
+ * @brief Gets the average time it took to bring back a chunk that had been shrunk in the cache
+ * @return Average rehydration time in milliseconds. Returns 0 if no chunk was rehydrated yet.
+ */
+float ChunkCache::GetAverageRehydrationTime() const
+{
+	if (m_numRehydrations == 0)
+	{
+		return 0.0f;
+	}
+
+	return static_cast<float>(m_totalRehydrationTime / m_numRehydrations);
+}
+
+/**
+ * @brief Gets the longest time it took to bring back a chunk that had been shrunk in the cache
+ * @return Maximum rehydration time in milliseconds
+ */
+float ChunkCache::GetMaxRehydrationTime() const
+{
+	return m_maxRehydrationTime;
+}
+
+/**
+ * @brief Measures the memory usage of a cached chunk again after it was shrunk
+ * @param[in] chunk Cached chunk
+ */
+void ChunkCache::UpdateChargedBytes(Chunk* chunk)
+{
+	Entry& entry = m_chunkMap[CoordinateUtils::PackChunkIndex(chunk->GetChunkIndexX(), chunk->GetChunkIndexY(), chunk->GetChunkIndexZ())];
+	m_residentBytes -= entry.chargedBytes;
+	entry.chargedBytes = chunk->GetMemoryUsage().GetTotal();
+	m_residentBytes += entry.chargedBytes;
+}
@@ -0,0 +1,76 @@
+#include "ChunkContainers/HashMapChunkContainer.hpp"
+
+#include "Utils/CoordinateUtils.hpp"
+
+/**
+ * @brief Constructor
+ */
+HashMapChunkContainer::HashMapChunkContainer()
+	: BaseChunkContainer()
+	, m_chunkMap()
+{
+}
+
+/**
+ * @brief Destructor
+ */
+HashMapChunkContainer::~HashMapChunkContainer()
+{
+}
+
+/**
+ * @brief Gets the chunk at the provided location indices
+ * @param[in] chunkIndexX Chunk x-index
+ * @param[in] chunkIndexY Chunk y-index
+ * @param[in] chunkIndexZ Chunk z-index
+ * @return Chunk at the provided location. Returns nullptr if there is no chunk at that location.
+ */
+Chunk* HashMapChunkContainer::Get(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ) const
+{
+	std::unordered_map<uint64_t, Chunk*>::const_iterator it = m_chunkMap.find(CoordinateUtils::PackChunkIndex(chunkIndexX, chunkIndexY, chunkIndexZ));
+	if (it != m_chunkMap.end())
+	{
+		return it->second;
+	}
+
+	return nullptr;
+}
+
+/**
+ * @brief Adds the chunk to the container
+ * @param[in] chunk Chunk to add
+ * @return True if the chunk was added, false if the container has no room for it
+ */
+bool HashMapChunkContainer::Add(Chunk* chunk)
+{
+	m_chunkMap[CoordinateUtils::PackChunkIndex(chunk->GetChunkIndexX(), chunk->GetChunkIndexY(), chunk->GetChunkIndexZ())] = chunk;
+	return true;
+}
+
+/**
+ * @brief Removes the chunk from the container
+ * @param[in] chunk Chunk to remove
+ */
+void HashMapChunkContainer::Remove(Chunk* chunk)
+{
+	m_chunkMap.erase(CoordinateUtils::PackChunkIndex(chunk->GetChunkIndexX(), chunk->GetChunkIndexY(), chunk->GetChunkIndexZ()));
+}
+
+/**
+ * @brief Removes all chunks from the container
+ */
+void HashMapChunkContainer::Clear()
+{
+	m_chunkMap.clear();
+}
+
+/**
+ * @brief Gets the number of bytes used by the container itself, not counting the chunks
+ * @return Memory usage in bytes
+ */
+size_t HashMapChunkContainer::GetMemoryUsage() const
+{
+	// Each node holds the key-value pair and a next pointer, and each bucket holds a pointer
+	size_t nodeSize = sizeof(std::pair<const uint64_t, Chunk*>) + sizeof(void*);
+	return sizeof(HashMapChunkContainer) + m_chunkMap.size() * nodeSize + m_chunkMap.bucket_count() * sizeof(void*);
+}
@@ -0,0 +1,104 @@
+#include "ChunkContainers/RingBufferChunkContainer.hpp"
+
+/**
+ * @brief Constructor
+ * @param[in] radius Horizontal radius in chunks of the loaded area. The grid is (2 * radius + 1) slots wide.
+ * @param[in] verticalRadius Vertical radius in chunks of the loaded area. The grid is (2 * verticalRadius + 1) slots tall.
+ */
+RingBufferChunkContainer::RingBufferChunkContainer(const int& radius, const int& verticalRadius)
+	: BaseChunkContainer()
+	, m_slots()
+	, m_size(2 * radius + 1)
+	, m_height(2 * verticalRadius + 1)
+{
+	m_slots.assign(static_cast<size_t>(m_size * m_size * m_height), nullptr);
+}
+
+/**
+ * @brief Destructor
+ */
+RingBufferChunkContainer::~RingBufferChunkContainer()
+{
+}
+
+/**
+ * @brief Gets the chunk at the provided location indices
+ * @param[in] chunkIndexX Chunk x-index
+ * @param[in] chunkIndexY Chunk y-index
+ * @param[in] chunkIndexZ Chunk z-index
+ * @return Chunk at the provided location. Returns nullptr if there is no chunk at that location.
+ */
+Chunk* RingBufferChunkContainer::Get(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ) const
+{
+	Chunk* chunk = m_slots[GetSlotIndex(chunkIndexX, chunkIndexY, chunkIndexZ)];
+
+	// The slot may be owned by a different chunk that maps to the same slot
+	if ((chunk != nullptr) && (chunk->GetChunkIndexX() == chunkIndexX) && (chunk->GetChunkIndexY() == chunkIndexY) && (chunk->GetChunkIndexZ() == chunkIndexZ))
+	{
+		return chunk;
+	}
+
+	return nullptr;
+}
+
+/**
+ * @brief Adds the chunk to the container
+ * @param[in] chunk Chunk to add
+ * @return True if the chunk was added, false if its slot is still occupied by another chunk
+ */
+bool RingBufferChunkContainer::Add(Chunk* chunk)
+{
+	Chunk*& slot = m_slots[GetSlotIndex(chunk->GetChunkIndexX(), chunk->GetChunkIndexY(), chunk->GetChunkIndexZ())];
+	if ((slot != nullptr) && (slot != chunk))
+	{
+		return false;
+	}
+
+	slot = chunk;
+	return true;
+}
+
+/**
+ * @brief Removes the chunk from the container
+ * @param[in] chunk Chunk to remove
+ */
+void RingBufferChunkContainer::Remove(Chunk* chunk)
+{
+	Chunk*& slot = m_slots[GetSlotIndex(chunk->GetChunkIndexX(), chunk->GetChunkIndexY(), chunk->GetChunkIndexZ())];
+	if (slot == chunk)
+	{
+		slot = nullptr;
+	}
+}
+
+/**
+ * @brief Removes all chunks from the container
+ */
+void RingBufferChunkContainer::Clear()
+{
+	m_slots.assign(m_slots.size(), nullptr);
+}
+
+/**
+ * @brief Gets the number of bytes used by the container itself, not counting the chunks
+ * @return Memory usage in bytes
+ */
+size_t RingBufferChunkContainer::GetMemoryUsage() const
+{
+	return sizeof(RingBufferChunkContainer) + m_slots.capacity() * sizeof(Chunk*);
+}
+
+/**
+ * @brief Gets the slot index for the provided location indices
+ * @param[in] chunkIndexX Chunk x-index
+ * @param[in] chunkIndexY Chunk y-index
+ * @param[in] chunkIndexZ Chunk z-index
+ * @return Slot index
+ */
+size_t RingBufferChunkContainer::GetSlotIndex(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ) const
+{
+	int slotX = ((chunkIndexX % m_size) + m_size) % m_size;
+	int slotY = ((chunkIndexY % m_height) + m_height) % m_height;
+	int slotZ = ((chunkIndexZ % m_size) + m_size) % m_size;
+	return static_cast<size_t>((slotY * m_size + slotZ) * m_size + slotX);
+}
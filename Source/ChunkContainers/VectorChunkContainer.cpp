@@ -0,0 +1,82 @@
+#include "ChunkContainers/VectorChunkContainer.hpp"
+
+/**
+ * @brief Constructor
+ */
+VectorChunkContainer::VectorChunkContainer()
+	: BaseChunkContainer()
+	, m_chunks()
+{
+}
+
+/**
+ * @brief Destructor
+ */
+VectorChunkContainer::~VectorChunkContainer()
+{
+}
+
+/**
+ * @brief Gets the chunk at the provided location indices
+ * @param[in] chunkIndexX Chunk x-index
+ * @param[in] chunkIndexY Chunk y-index
+ * @param[in] chunkIndexZ Chunk z-index
+ * @return Chunk at the provided location. Returns nullptr if there is no chunk at that location.
+ */
+Chunk* VectorChunkContainer::Get(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ) const
+{
+	for (size_t i = 0; i < m_chunks.size(); ++i)
+	{
+		if ((m_chunks[i]->GetChunkIndexX() == chunkIndexX) && (m_chunks[i]->GetChunkIndexY() == chunkIndexY) && (m_chunks[i]->GetChunkIndexZ() == chunkIndexZ))
+		{
+			return m_chunks[i];
+		}
+	}
+
+	return nullptr;
+}
+
+/**
+ * @brief Adds the chunk to the container
+ * @param[in] chunk Chunk to add
+ * @return True if the chunk was added, false if the container has no room for it
+ */
+bool VectorChunkContainer::Add(Chunk* chunk)
+{
+	m_chunks.push_back(chunk);
+	return true;
+}
+
+/**
+ * @brief Removes the chunk from the container
+ * @param[in] chunk Chunk to remove
+ */
+void VectorChunkContainer::Remove(Chunk* chunk)
+{
+	for (size_t i = 0; i < m_chunks.size(); ++i)
+	{
+		if (m_chunks[i] == chunk)
+		{
+			m_chunks[i] = m_chunks.back();
+			m_chunks.pop_back();
+			return;
+		}
+	}
+}
+
+/**
+ * @brief Removes all chunks from the container
+ */
+void VectorChunkContainer::Clear()
+{
+	m_chunks.clear();
+}
+
+/**
+ * @brief Gets the number of bytes used by the container itself, not counting the chunks
+ * @return Memory usage in bytes
+ */
+size_t VectorChunkContainer::GetMemoryUsage() const
+{
+	return sizeof(VectorChunkContainer) + m_chunks.capacity() * sizeof(Chunk*);
+}
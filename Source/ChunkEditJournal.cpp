@@ -0,0 +1,232 @@
+#include "ChunkEditJournal.hpp"
+
+#include "Constants.hpp"
+
+#include <cstring>
+#include <unordered_map>
+
+static_assert((Constants::CHUNK_WIDTH == 16) && (Constants::CHUNK_DEPTH == 16) && (Constants::CHUNK_HEIGHT <= 256),
+	"Packed positions in the edit journal use 4 bits for x and z, and 8 bits for y");
+
+/**
+ * @brief Constructor
+ */
+ChunkEditJournal::ChunkEditJournal()
+	: m_entries()
+	, m_numCompactedEntries(0)
+{
+}
+
+/**
+ * @brief Destructor
+ */
+ChunkEditJournal::~ChunkEditJournal()
+{
+}
+
+/**
+ * @brief Records a block change.
+ * The journal is compacted once it has grown to twice its compacted size.
+ * @param[in] x X-coordinate
+ * @param[in] y Y-coordinate
+ * @param[in] z Z-coordinate
+ * @param[in] oldType Type of the block before the change
+ * @param[in] newType Type of the block after the change
+ */
+void ChunkEditJournal::Append(const int& x, const int& y, const int& z, const BlockTypeEnum& oldType, const BlockTypeEnum& newType)
+{
+	Entry entry;
+	entry.packedPosition = PackPosition(x, y, z);
+	entry.baseType = oldType;
+	entry.type = newType;
+	m_entries.push_back(entry);
+
+	// Compacting at geometric intervals keeps the cost per append constant
+	if (m_entries.size() >= 2 * m_numCompactedEntries + 64)
+	{
+		Compact();
+	}
+}
+
+/**
+ * @brief Merges entries for the same block into one, and drops blocks that were changed back to their generated type
+ */
+void ChunkEditJournal::Compact()
+{
+	// Maps each packed position to the index of its merged entry
+	std::unordered_map<uint16_t, size_t> mergedEntryIndices;
+	mergedEntryIndices.reserve(m_entries.size());
+
+	std::vector<Entry> mergedEntries;
+	mergedEntries.reserve(m_entries.size());
+	for (size_t i = 0; i < m_entries.size(); ++i)
+	{
+		std::unordered_map<uint16_t, size_t>::iterator it = mergedEntryIndices.find(m_entries[i].packedPosition);
+		if (it == mergedEntryIndices.end())
+		{
+			mergedEntryIndices[m_entries[i].packedPosition] = mergedEntries.size();
+			mergedEntries.push_back(m_entries[i]);
+		}
+		else
+		{
+			// Keep the type from before the first change and the type after the last change
+			mergedEntries[it->second].type = m_entries[i].type;
+		}
+	}
+
+	m_entries.clear();
+	for (size_t i = 0; i < mergedEntries.size(); ++i)
+	{
+		if (mergedEntries[i].baseType != mergedEntries[i].type)
+		{
+			m_entries.push_back(mergedEntries[i]);
+		}
+	}
+
+	m_numCompactedEntries = m_entries.size();
+}
+
+/**
+ * @brief Removes every entry
+ */
+void ChunkEditJournal::Clear()
+{
+	m_entries.clear();
+	m_numCompactedEntries = 0;
+}
+
+/**
+ * @brief Checks whether the journal has no entries
+ * @return True if the journal has no entries
+ */
+bool ChunkEditJournal::IsEmpty() const
+{
+	return m_entries.empty();
+}
+
+/**
+ * @brief Gets the entries of the journal
+ * @return Entries in the order the changes were made
+ */
+const std::vector<ChunkEditJournal::Entry>& ChunkEditJournal::GetEntries() const
+{
+	return m_entries;
+}
+
+/**
+ * @brief Gets the number of bytes the serialized journal takes up
+ * @return Serialized size in bytes
+ */
+size_t ChunkEditJournal::GetSerializedSize() const
+{
+	return sizeof(uint32_t) + m_entries.size() * 4;
+}
+
+/**
+ * @brief Gets the number of bytes allocated for the entries
+ * @return Memory usage in bytes
+ */
+size_t ChunkEditJournal::GetMemoryUsage() const
+{
+	return m_entries.capacity() * sizeof(Entry);
+}
+
+/**
+ * @brief Appends the entries of the journal to the buffer
+ * @param[out] buffer Buffer to append to
+ */
+void ChunkEditJournal::Serialize(std::vector<uint8_t>& buffer) const
+{
+	// Layout: number of entries (4 bytes), followed by the packed position (2 bytes),
+	// base type (1 byte) and type (1 byte) of each entry. Multi-byte values are written in host byte order.
+	uint32_t numEntries = static_cast<uint32_t>(m_entries.size());
+
+	size_t offset = buffer.size();
+	buffer.resize(offset + GetSerializedSize());
+	memcpy(&buffer[offset], &numEntries, sizeof(numEntries));
+	offset += sizeof(numEntries);
+
+	for (size_t i = 0; i < m_entries.size(); ++i)
+	{
+		memcpy(&buffer[offset], &m_entries[i].packedPosition, sizeof(uint16_t));
+		buffer[offset + 2] = static_cast<uint8_t>(m_entries[i].baseType);
+		buffer[offset + 3] = static_cast<uint8_t>(m_entries[i].type);
+		offset += 4;
+	}
+}
+
+/**
+ * @brief Reads serialized entries without storing them
+ * @param[in] data Serialized data
+ * @param[in] size Number of bytes available in the data
+ * @param[out] entries Entries read from the data
+ * @return True if the data was read, false if it is malformed
+ */
+bool ChunkEditJournal::Deserialize(const uint8_t* data, const size_t& size, std::vector<Entry>& entries)
+{
+	entries.clear();
+
+	uint32_t numEntries = 0;
+	if (size < sizeof(numEntries))
+	{
+		return false;
+	}
+	memcpy(&numEntries, data, sizeof(numEntries));
+
+	if ((size - sizeof(numEntries)) / 4 < numEntries)
+	{
+		return false;
+	}
+
+	entries.resize(numEntries);
+	const uint8_t* entryData = data + sizeof(numEntries);
+	for (uint32_t i = 0; i < numEntries; ++i)
+	{
+		Entry& entry = entries[i];
+		memcpy(&entry.packedPosition, entryData, sizeof(uint16_t));
+
+		int x = 0;
+		int y = 0;
+		int z = 0;
+		UnpackPosition(entry.packedPosition, x, y, z);
+		if ((y >= Constants::CHUNK_HEIGHT)
+			|| (entryData[2] >= static_cast<uint8_t>(BlockTypeEnum::COUNT))
+			|| (entryData[3] >= static_cast<uint8_t>(BlockTypeEnum::COUNT)))
+		{
+			entries.clear();
+			return false;
+		}
+
+		entry.baseType = static_cast<BlockTypeEnum>(entryData[2]);
+		entry.type = static_cast<BlockTypeEnum>(entryData[3]);
+		entryData += 4;
+	}
+
+	return true;
+}
+
+/**
+ * @brief Packs a block position within a chunk
+ * @param[in] x X-coordinate
+ * @param[in] y Y-coordinate
+ * @param[in] z Z-coordinate
+ * @return Packed position
+ */
+uint16_t ChunkEditJournal::PackPosition(const int& x, const int& y, const int& z)
+{
+	return static_cast<uint16_t>((y << 8) | (z << 4) | x);
+}
+
+/**
+ * @brief Unpacks a block position within a chunk
+ * @param[in] packedPosition Packed position
+ * @param[out] x X-coordinate
+ * @param[out] y Y-coordinate
+ * @param[out] z Z-coordinate
+ */
+void ChunkEditJournal::UnpackPosition(const uint16_t& packedPosition, int& x, int& y, int& z)
+{
+	x = packedPosition & 0xF;
+	z = (packedPosition >> 4) & 0xF;
+	y = packedPosition >> 8;
+}
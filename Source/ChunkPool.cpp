@@ -0,0 +1,106 @@
+#include "ChunkPool.hpp"
+
+/**
+ * @brief Constructor
+ * @param[in] capacity Maximum number of chunks kept in the pool
+ */
+ChunkPool::ChunkPool(const size_t& capacity)
+	: m_freeChunks()
+	, m_capacity(capacity)
+	, m_numHits(0)
+	, m_numMisses(0)
+{
+	m_freeChunks.reserve(capacity);
+}
+
+/**
+ * @brief Destructor
+ */
+ChunkPool::~ChunkPool()
+{
+	for (size_t i = 0; i < m_freeChunks.size(); ++i)
+	{
+		delete m_freeChunks[i];
+	}
+	m_freeChunks.clear();
+}
+
+/**
+ * @brief Gets an empty chunk at the provided location indices, reusing a pooled chunk if there is one
+ * @param[in] chunkIndexX Chunk x-index
+ * @param[in] chunkIndexY Chunk y-index
+ * @param[in] chunkIndexZ Chunk z-index
+ * @return Empty chunk
+ */
+Chunk* ChunkPool::Acquire(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ)
+{
+	if (m_freeChunks.empty())
+	{
+		++m_numMisses;
+		return new Chunk(chunkIndexX, chunkIndexY, chunkIndexZ);
+	}
+
+	++m_numHits;
+	Chunk* chunk = m_freeChunks.back();
+	m_freeChunks.pop_back();
+	chunk->Reset(chunkIndexX, chunkIndexY, chunkIndexZ);
+	return chunk;
+}
+
+/**
+ * @brief Returns the chunk to the pool
+ * @param[in] chunk Chunk to return
+ * @return True if the chunk was pooled. Returns false if the pool is full, in which case the caller keeps ownership of the chunk.
+ */
+bool ChunkPool::Release(Chunk* chunk)
+{
+	if (m_freeChunks.size() >= m_capacity)
+	{
+		return false;
+	}
+
+	m_freeChunks.push_back(chunk);
+	return true;
+}
+
+/**
+ * @brief Gets the number of chunks currently in the pool
+ * @return Number of pooled chunks
+ */
+size_t ChunkPool::GetPooledChunkCount() const
+{
+	return m_freeChunks.size();
+}
+
+/**
+ * @brief Gets the number of acquisitions that reused a pooled chunk
+ * @return Number of pool hits
+ */
+uint64_t ChunkPool::GetHitCount() const
+{
+	return m_numHits;
+}
+
+/**
+ * @brief Gets the number of acquisitions that had to allocate a new chunk
+ * @return Number of pool misses
+ */
+uint64_t ChunkPool::GetMissCount() const
+{
+	return m_numMisses;
+}
+
+/**
+ * @brief Gets the number of bytes used by the pooled chunks
+ * @return Memory usage of the pooled chunks
+ */
+MemoryUsage ChunkPool::GetMemoryUsage() const
+{
+	MemoryUsage ret;
+	ret.bookkeepingBytes = m_freeChunks.capacity() * sizeof(Chunk*);
+	for (size_t i = 0; i < m_freeChunks.size(); ++i)
+	{
+		ret += m_freeChunks[i]->GetMemoryUsage();
+	}
+	return ret;
+}
@@ -0,0 +1,101 @@
+#include "ChunkReclaimer.hpp"
+
+#include <vector>
+
+/**
+ * @brief Constructor. Starts the background thread.
+ */
+ChunkReclaimer::ChunkReclaimer()
+	: m_pendingChunks()
+	, m_mutex()
+	, m_condition()
+	, m_isStopping(false)
+	, m_numReclaimedChunks(0)
+	, m_thread()
+{
+	// Started last so that the thread never sees a partially constructed reclaimer
+	m_thread = std::thread(&ChunkReclaimer::Run, this);
+}
+
+/**
+ * @brief Destructor. Deletes the pending chunks and stops the background thread.
+ */
+ChunkReclaimer::~ChunkReclaimer()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_isStopping = true;
+	}
+	m_condition.notify_one();
+
+	if (m_thread.joinable())
+	{
+		m_thread.join();
+	}
+}
+
+/**
+ * @brief Hands the chunk over to the background thread, which deletes it.
+ * The chunk should already be removed from the world and its caches.
+ * @param[in] chunk Chunk to delete
+ */
+void ChunkReclaimer::Reclaim(Chunk* chunk)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_pendingChunks.push_back(chunk);
+	}
+	m_condition.notify_one();
+}
+
+/**
+ * @brief Gets the number of chunks waiting to be deleted
+ * @return Number of pending chunks
+ */
+size_t ChunkReclaimer::GetPendingCount() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_pendingChunks.size();
+}
+
+/**
+ * @brief Gets the number of chunks deleted by the background thread
+ * @return Number of reclaimed chunks
+ */
+uint64_t ChunkReclaimer::GetReclaimedCount() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_numReclaimedChunks;
+}
+
+/**
+ * @brief Deletes chunks as they are handed over until the reclaimer is stopped
+ */
+void ChunkReclaimer::Run()
+{
+	std::vector<Chunk*> chunksToDelete;
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (true)
+	{
+		m_condition.wait(lock, [this]() { return m_isStopping || !m_pendingChunks.empty(); });
+		if (m_pendingChunks.empty())
+		{
+			// Only reached when stopping, after every pending chunk was deleted
+			break;
+		}
+
+		// The chunks are deleted without holding the lock, so handing over more chunks never waits on a deletion
+		chunksToDelete.assign(m_pendingChunks.begin(), m_pendingChunks.end());
+		m_pendingChunks.clear();
+		lock.unlock();
+
+		for (size_t i = 0; i < chunksToDelete.size(); ++i)
+		{
+			delete chunksToDelete[i];
+		}
+
+		lock.lock();
+		m_numReclaimedChunks += chunksToDelete.size();
+		chunksToDelete.clear();
+	}
+}
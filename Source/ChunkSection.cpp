@@ -0,0 +1,295 @@
+#include "ChunkSection.hpp"
+
+#include "BlockUtils.hpp"
+#include "Constants.hpp"
+
+static_assert((Constants::CHUNK_WIDTH == 16) && (Constants::CHUNK_DEPTH % 4 == 0),
+	"Occupancy masks pack four rows of 16 blocks into each word");
+
+/**
+ * @brief Constructor. The section starts out filled with air.
+ */
+ChunkSection::ChunkSection()
+	: m_blocks(Constants::CHUNK_WIDTH * Constants::CHUNK_DEPTH * Constants::SECTION_HEIGHT)
+	, m_numNonAirBlocks(0)
+	, m_solidMask()
+	, m_liquidMask()
+	, m_isShared(false)
+{
+}
+
+/**
+ * @brief Copy constructor. The copy is not registered anywhere, so it can be modified.
+ * @param[in] other Section to copy
+ */
+ChunkSection::ChunkSection(const ChunkSection& other)
+	: m_blocks(other.m_blocks)
+	, m_numNonAirBlocks(other.m_numNonAirBlocks)
+	, m_solidMask(other.m_solidMask)
+	, m_liquidMask(other.m_liquidMask)
+	, m_isShared(false)
+{
+}
+
+/**
+ * @brief Destructor
+ */
+ChunkSection::~ChunkSection()
+{
+}
+
+/**
+ * @brief Gets the block at the specified location
+ * @param[in] x X-coordinate within the section
+ * @param[in] y Y-coordinate within the section
+ * @param[in] z Z-coordinate within the section
+ * @return Type of the block at the specified location
+ */
+BlockTypeEnum ChunkSection::GetBlockAt(const int& x, const int& y, const int& z) const
+{
+	int index = (y * Constants::CHUNK_DEPTH + z) * Constants::CHUNK_WIDTH + x;
+	return m_blocks.Get(static_cast<uint32_t>(index));
+}
+
+/**
+ * @brief Sets the block at the specified location
+ * @param[in] x X-coordinate within the section
+ * @param[in] y Y-coordinate within the section
+ * @param[in] z Z-coordinate within the section
+ * @param[in] type Type of the new block
+ */
+void ChunkSection::SetBlockAt(const int& x, const int& y, const int& z, const BlockTypeEnum& type)
+{
+	int index = (y * Constants::CHUNK_DEPTH + z) * Constants::CHUNK_WIDTH + x;
+
+	BlockTypeEnum existingType = m_blocks.Get(static_cast<uint32_t>(index));
+	if (existingType == type)
+	{
+		return;
+	}
+
+	if (existingType == BlockTypeEnum::AIR)
+	{
+		++m_numNonAirBlocks;
+	}
+	else if (type == BlockTypeEnum::AIR)
+	{
+		--m_numNonAirBlocks;
+	}
+
+	m_blocks.Set(static_cast<uint32_t>(index), type);
+
+	// Blocks are stored in the same order as the mask bits
+	uint64_t bit = 1ull << (index & 63);
+	m_solidMask[index >> 6] = BlockUtils::IsSolid(type) ? (m_solidMask[index >> 6] | bit) : (m_solidMask[index >> 6] & ~bit);
+	m_liquidMask[index >> 6] = BlockUtils::IsLiquid(type) ? (m_liquidMask[index >> 6] | bit) : (m_liquidMask[index >> 6] & ~bit);
+}
+
+/**
+ * @brief Resets every block in this section to air, keeping the allocated storage for reuse
+ */
+void ChunkSection::Clear()
+{
+	m_blocks.Clear();
+	m_numNonAirBlocks = 0;
+	m_solidMask.fill(0);
+	m_liquidMask.fill(0);
+}
+
+/**
+ * @brief Checks whether this section only contains air
+ * @return True if this section only contains air, false otherwise
+ */
+bool ChunkSection::IsEmpty() const
+{
+	return m_numNonAirBlocks == 0;
+}
+
+/**
+ * @brief Checks whether every block in this section has the same type
+ * @return True if every block in this section has the same type, false otherwise
+ */
+bool ChunkSection::IsUniform() const
+{
+	return m_blocks.IsUniform();
+}
+
+/**
+ * @brief Gets the number of non-air blocks in this section
+ * @return Number of non-air blocks
+ */
+uint32_t ChunkSection::GetNonAirBlockCount() const
+{
+	return m_numNonAirBlocks;
+}
+
+/**
+ * @brief Checks whether the block at the specified location is solid
+ * @param[in] x X-coordinate within the section
+ * @param[in] y Y-coordinate within the section
+ * @param[in] z Z-coordinate within the section
+ * @return True if the block is solid
+ */
+bool ChunkSection::IsSolidAt(const int& x, const int& y, const int& z) const
+{
+	int index = (y * Constants::CHUNK_DEPTH + z) * Constants::CHUNK_WIDTH + x;
+	return ((m_solidMask[index >> 6] >> (index & 63)) & 1) != 0;
+}
+
+/**
+ * @brief Checks whether the block at the specified location is a liquid
+ * @param[in] x X-coordinate within the section
+ * @param[in] y Y-coordinate within the section
+ * @param[in] z Z-coordinate within the section
+ * @return True if the block is a liquid
+ */
+bool ChunkSection::IsLiquidAt(const int& x, const int& y, const int& z) const
+{
+	int index = (y * Constants::CHUNK_DEPTH + z) * Constants::CHUNK_WIDTH + x;
+	return ((m_liquidMask[index >> 6] >> (index & 63)) & 1) != 0;
+}
+
+/**
+ * @brief Gets a word of the solid block mask
+ * @param[in] wordIndex Word index, which is (y << 2) | (z >> 2)
+ * @return Solid block bits of four rows along the x-axis
+ */
+uint64_t ChunkSection::GetSolidMaskWord(const int& wordIndex) const
+{
+	return m_solidMask[wordIndex];
+}
+
+/**
+ * @brief Gets a word of the liquid block mask
+ * @param[in] wordIndex Word index, which is (y << 2) | (z >> 2)
+ * @return Liquid block bits of four rows along the x-axis
+ */
+uint64_t ChunkSection::GetLiquidMaskWord(const int& wordIndex) const
+{
+	return m_liquidMask[wordIndex];
+}
+
+/**
+ * @brief Compacts the block storage of this section.
+ * Uniform sections end up storing a single value.
+ */
+void ChunkSection::Compact()
+{
+	m_blocks.Compact();
+}
+
+/**
+ * @brief Gets the number of bytes used by this section
+ * @return Memory usage in bytes
+ */
+size_t ChunkSection::GetMemoryUsage() const
+{
+	return sizeof(ChunkSection) - sizeof(BlockStorage) + m_blocks.GetMemoryUsage();
+}
+
+/**
+ * @brief Appends the block data of this section to the buffer
+ * @param[out] buffer Buffer to append to
+ */
+void ChunkSection::Serialize(std::vector<uint8_t>& buffer) const
+{
+	m_blocks.Serialize(buffer);
+}
+
+/**
+ * @brief Replaces the block data of this section with serialized data
+ * @param[in] data Serialized data
+ * @param[in] size Number of bytes available in the data
+ * @return Number of bytes read. Returns 0 if the data is malformed.
+ */
+size_t ChunkSection::Deserialize(const uint8_t* data, const size_t& size)
+{
+	size_t numBytesRead = m_blocks.Deserialize(data, size);
+	RecalculateOccupancy();
+	return numBytesRead;
+}
+
+/**
+ * @brief Appends the run-length encoded block data of this section to the buffer
+ * @param[out] buffer Buffer to append to
+ */
+void ChunkSection::EncodeRuns(std::vector<uint8_t>& buffer) const
+{
+	m_blocks.EncodeRuns(buffer);
+}
+
+/**
+ * @brief Replaces the block data of this section with run-length encoded data
+ * @param[in] data Encoded data
+ * @param[in] size Number of bytes available in the data
+ * @return Number of bytes read. Returns 0 if the data is malformed.
+ */
+size_t ChunkSection::DecodeRuns(const uint8_t* data, const size_t& size)
+{
+	size_t numBytesRead = m_blocks.DecodeRuns(data, size);
+	RecalculateOccupancy();
+	return numBytesRead;
+}
+
+/**
+ * @brief Gets a hash of the block data of this section
+ * @return Content hash
+ */
+uint64_t ChunkSection::GetContentHash() const
+{
+	return m_blocks.GetContentHash();
+}
+
+/**
+ * @brief Checks whether this section stores the same block data as another section
+ * @param[in] other Section to compare with
+ * @return True if both sections have the same content
+ */
+bool ChunkSection::HasSameContent(const ChunkSection& other) const
+{
+	// The block counts and occupancy masks follow from the block data
+	return m_blocks.HasSameContent(other.m_blocks);
+}
+
+/**
+ * @brief Marks this section as registered in a SharedSectionTable, which makes it immutable
+ */
+void ChunkSection::MarkShared()
+{
+	m_isShared = true;
+}
+
+/**
+ * @brief Checks whether this section was registered in a SharedSectionTable
+ * @return True if this section must not be modified, false otherwise
+ */
+bool ChunkSection::IsShared() const
+{
+	return m_isShared;
+}
+
+/**
+ * @brief Counts the non-air blocks and rebuilds the occupancy masks after the block data was replaced
+ */
+void ChunkSection::RecalculateOccupancy()
+{
+	m_numNonAirBlocks = 0;
+	m_solidMask.fill(0);
+	m_liquidMask.fill(0);
+	for (uint32_t i = 0; i < m_blocks.GetSize(); ++i)
+	{
+		BlockTypeEnum type = m_blocks.Get(i);
+		if (type != BlockTypeEnum::AIR)
+		{
+			++m_numNonAirBlocks;
+		}
+		if (BlockUtils::IsSolid(type))
+		{
+			m_solidMask[i >> 6] |= 1ull << (i & 63);
+		}
+		else if (BlockUtils::IsLiquid(type))
+		{
+			m_liquidMask[i >> 6] |= 1ull << (i & 63);
+		}
+	}
+}
@@ -0,0 +1,116 @@
+#include "ChunkSnapshot.hpp"
+
+/**
+ * @brief Constructor. Creates an empty snapshot that only contains air.
+ */
+ChunkSnapshot::ChunkSnapshot()
+	: m_sections()
+	, m_heightMap()
+	, m_minHeight(Constants::CHUNK_HEIGHT)
+	, m_maxHeight(0)
+	, m_chunkIndex(0)
+	, m_version(0)
+{
+}
+
+/**
+ * @brief Constructor
+ * @param[in] chunkIndex Chunk indices in each axis
+ * @param[in] version Version of the chunk
+ * @param[in] sections Sections of the chunk
+ * @param[in] heightMap Height of each column
+ * @param[in] minHeight Lower bound of the lowest non-air block
+ * @param[in] maxHeight Height of the tallest column
+ */
+ChunkSnapshot::ChunkSnapshot(const glm::ivec3& chunkIndex, const uint64_t& version, const SectionArray& sections,
+	const HeightMap& heightMap, const int& minHeight, const int& maxHeight)
+	: m_sections(sections)
+	, m_heightMap(heightMap)
+	, m_minHeight(minHeight)
+	, m_maxHeight(maxHeight)
+	, m_chunkIndex(chunkIndex)
+	, m_version(version)
+{
+}
+
+/**
+ * @brief Destructor
+ */
+ChunkSnapshot::~ChunkSnapshot()
+{
+}
+
+/**
+ * @brief Gets the chunk indices in each axis of the chunk the snapshot was taken from
+ * @return Chunk indices for each axis
+ */
+glm::ivec3 ChunkSnapshot::GetChunkIndices() const
+{
+	return m_chunkIndex;
+}
+
+/**
+ * @brief Gets the version of the chunk at the time the snapshot was taken
+ * @return Chunk version
+ */
+uint64_t ChunkSnapshot::GetVersion() const
+{
+	return m_version;
+}
+
+/**
+ * @brief Gets the block at the specified location
+ * @param[in] x X-coordinate
+ * @param[in] y Y-coordinate
+ * @param[in] z z-coordinate
+ * @return Type of the block at the specified location
+ */
+BlockTypeEnum ChunkSnapshot::GetBlockAt(const int& x, const int& y, const int& z) const
+{
+	const ChunkSection* section = m_sections[y / Constants::SECTION_HEIGHT].get();
+	if (section == nullptr)
+	{
+		return BlockTypeEnum::AIR;
+	}
+
+	return section->GetBlockAt(x, y % Constants::SECTION_HEIGHT, z);
+}
+
+/**
+ * @brief Gets the height of the specified column
+ * @param[in] x X-coordinate
+ * @param[in] z Z-coordinate
+ * @return Height of the column. Returns 0 if the column only contains air.
+ */
+int ChunkSnapshot::GetHeightAt(const int& x, const int& z) const
+{
+	return m_heightMap[z * Constants::CHUNK_WIDTH + x];
+}
+
+/**
+ * @brief Gets a lower bound of the y-coordinate of the lowest non-air block
+ * @return Lower bound of the lowest non-air block. Returns Constants::CHUNK_HEIGHT if the snapshot is empty.
+ */
+int ChunkSnapshot::GetMinHeight() const
+{
+	return m_minHeight;
+}
+
+/**
+ * @brief Gets the height of the tallest column
+ * @return Height of the tallest column
+ */
+int ChunkSnapshot::GetMaxHeight() const
+{
+	return m_maxHeight;
+}
+
+/**
+ * @brief Gets the section at the specified section index
+ * @param[in] sectionIndex Section index
+ * @return Section at the specified index. Returns nullptr if the section only contains air.
+ */
+const ChunkSection* ChunkSnapshot::GetSection(const int& sectionIndex) const
+{
+	return m_sections[sectionIndex].get();
+}
@@ -41,9 +41,11 @@ void BlockTemplateManager::AddBlockTemplate(const BlockTypeEnum& blockType, cons
  */
 const BlockTemplate* BlockTemplateManager::GetBlockTemplate(const BlockTypeEnum& blockType)
 {
-	if (m_templates.find(blockType) != m_templates.end())
+	// Meshes are built on worker threads, so the lookup must not go through operator[]
+	std::map<BlockTypeEnum, BlockTemplate>::const_iterator it = m_templates.find(blockType);
+	if (it != m_templates.end())
 	{
-		return &m_templates[blockType];
+		return &it->second;
 	}
 
 	return nullptr;
@@ -0,0 +1,70 @@
+#include "GLDeletionQueue.hpp"
+
+/**
+ * @brief Constructor
+ */
+GLDeletionQueue::GLDeletionQueue()
+	: m_buffers()
+	, m_vertexArrays()
+{
+}
+
+/**
+ * @brief Destructor. Deletes the objects that are still in the queue.
+ */
+GLDeletionQueue::~GLDeletionQueue()
+{
+	Flush();
+}
+
+/**
+ * @brief Adds the buffer to the queue. Does nothing if the handle is 0.
+ * @param[in] buffer Buffer handle
+ */
+void GLDeletionQueue::EnqueueBuffer(const GLuint& buffer)
+{
+	if (buffer != 0)
+	{
+		m_buffers.push_back(buffer);
+	}
+}
+
+/**
+ * @brief Adds the vertex array to the queue. Does nothing if the handle is 0.
+ * @param[in] vertexArray Vertex array handle
+ */
+void GLDeletionQueue::EnqueueVertexArray(const GLuint& vertexArray)
+{
+	if (vertexArray != 0)
+	{
+		m_vertexArrays.push_back(vertexArray);
+	}
+}
+
+/**
+ * @brief Deletes every object in the queue. Should be called on the render thread.
+ */
+void GLDeletionQueue::Flush()
+{
+	// One call per object type instead of one per object
+	if (!m_vertexArrays.empty())
+	{
+		glDeleteVertexArrays(static_cast<GLsizei>(m_vertexArrays.size()), m_vertexArrays.data());
+		m_vertexArrays.clear();
+	}
+
+	if (!m_buffers.empty())
+	{
+		glDeleteBuffers(static_cast<GLsizei>(m_buffers.size()), m_buffers.data());
+		m_buffers.clear();
+	}
+}
+
+/**
+ * @brief Gets the number of objects waiting to be deleted
+ * @return Number of queued objects
+ */
+size_t GLDeletionQueue::GetPendingCount() const
+{
+	return m_buffers.size() + m_vertexArrays.size();
+}
@@ -0,0 +1,369 @@
+#include "IO/IoUringChunkIO.hpp"
+
+#ifdef __linux__
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+
+/**
+ * @brief Constructor. Creates the io_uring instance.
+ * @param[in] queueDepth Maximum number of requests in flight at once
+ */
+IoUringChunkIO::IoUringChunkIO(const unsigned int& queueDepth)
+	: BaseChunkIO()
+	, m_ringFileDescriptor(-1)
+	, m_queueDepth(0)
+	, m_submissionRing(nullptr)
+	, m_submissionRingSize(0)
+	, m_completionRing(nullptr)
+	, m_completionRingSize(0)
+	, m_submissionEntries(nullptr)
+	, m_numSubmissionEntries(0)
+	, m_submissionHead(nullptr)
+	, m_submissionTail(nullptr)
+	, m_submissionMask(0)
+	, m_submissionArray(nullptr)
+	, m_completionHead(nullptr)
+	, m_completionTail(nullptr)
+	, m_completionMask(0)
+	, m_completionEntries(nullptr)
+	, m_batch()
+	, m_completedRequests()
+	, m_numInFlight(0)
+{
+	io_uring_params params;
+	memset(&params, 0, sizeof(params));
+	m_ringFileDescriptor = static_cast<int>(syscall(__NR_io_uring_setup, queueDepth, &params));
+	if (m_ringFileDescriptor < 0)
+	{
+		m_ringFileDescriptor = -1;
+		return;
+	}
+
+	// Plain read and write operations were added in the same kernel version as this feature
+	if ((params.features & IORING_FEAT_RW_CUR_POS) == 0)
+	{
+		Destroy();
+		return;
+	}
+
+	m_numSubmissionEntries = params.sq_entries;
+	m_queueDepth = std::min(queueDepth, params.sq_entries);
+	m_submissionRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+	m_completionRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+	bool isSingleMapping = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+	if (isSingleMapping)
+	{
+		m_submissionRingSize = std::max(m_submissionRingSize, m_completionRingSize);
+		m_completionRingSize = m_submissionRingSize;
+	}
+
+	void* submissionRing = mmap(nullptr, m_submissionRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ringFileDescriptor, IORING_OFF_SQ_RING);
+	if (submissionRing == MAP_FAILED)
+	{
+		Destroy();
+		return;
+	}
+	m_submissionRing = submissionRing;
+
+	if (isSingleMapping)
+	{
+		m_completionRing = m_submissionRing;
+	}
+	else
+	{
+		void* completionRing = mmap(nullptr, m_completionRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ringFileDescriptor, IORING_OFF_CQ_RING);
+		if (completionRing == MAP_FAILED)
+		{
+			Destroy();
+			return;
+		}
+		m_completionRing = completionRing;
+	}
+
+	void* submissionEntries = mmap(nullptr, params.sq_entries * sizeof(io_uring_sqe), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ringFileDescriptor, IORING_OFF_SQES);
+	if (submissionEntries == MAP_FAILED)
+	{
+		Destroy();
+		return;
+	}
+	m_submissionEntries = static_cast<io_uring_sqe*>(submissionEntries);
+
+	uint8_t* submissionRingBytes = static_cast<uint8_t*>(m_submissionRing);
+	m_submissionHead = reinterpret_cast<unsigned int*>(submissionRingBytes + params.sq_off.head);
+	m_submissionTail = reinterpret_cast<unsigned int*>(submissionRingBytes + params.sq_off.tail);
+	m_submissionMask = *reinterpret_cast<unsigned int*>(submissionRingBytes + params.sq_off.ring_mask);
+	m_submissionArray = reinterpret_cast<unsigned int*>(submissionRingBytes + params.sq_off.array);
+
+	uint8_t* completionRingBytes = static_cast<uint8_t*>(m_completionRing);
+	m_completionHead = reinterpret_cast<unsigned int*>(completionRingBytes + params.cq_off.head);
+	m_completionTail = reinterpret_cast<unsigned int*>(completionRingBytes + params.cq_off.tail);
+	m_completionMask = *reinterpret_cast<unsigned int*>(completionRingBytes + params.cq_off.ring_mask);
+	m_completionEntries = reinterpret_cast<io_uring_cqe*>(completionRingBytes + params.cq_off.cqes);
+}
+
+/**
+ * @brief Destructor. Waits for the submitted requests, then destroys the io_uring instance.
+ * Callbacks of requests that were not polled yet are not invoked.
+ */
+IoUringChunkIO::~IoUringChunkIO()
+{
+	if (IsInitialized())
+	{
+		WaitForAll();
+	}
+	Destroy();
+
+	for (size_t i = 0; i < m_completedRequests.size(); ++i)
+	{
+		delete m_completedRequests[i];
+	}
+	m_completedRequests.clear();
+
+	for (size_t i = 0; i < m_batch.size(); ++i)
+	{
+		delete m_batch[i];
+	}
+	m_batch.clear();
+}
+
+/**
+ * @brief Checks whether the io_uring instance was created. The backend cannot be used otherwise.
+ * @return True if the io_uring instance is ready
+ */
+bool IoUringChunkIO::IsInitialized() const
+{
+	return m_submissionEntries != nullptr;
+}
+
+/**
+ * @brief Gets the type of this backend
+ * @return Backend type
+ */
+ChunkIOBackendEnum IoUringChunkIO::GetBackendType() const
+{
+	return ChunkIOBackendEnum::IO_URING;
+}
+
+/**
+ * @brief Adds the request to the batch that is handed to the backend on the next call to Submit()
+ * @param[in] request Request to add. The backend takes ownership of the request.
+ */
+void IoUringChunkIO::Enqueue(ChunkIORequest* request)
+{
+	request->succeeded = false;
+	m_batch.push_back(request);
+	++m_numPendingRequests;
+}
+
+/**
+ * @brief Places the enqueued requests in the submission queue and submits them to the kernel.
+ * Waits for completions whenever the queue depth is reached.
+ */
+void IoUringChunkIO::Submit()
+{
+	// Entries left in the submission queue by a failed call are retried even if nothing new was enqueued
+	if (m_batch.empty())
+	{
+		Enter(0);
+		return;
+	}
+
+	size_t numSubmitted = 0;
+	while (numSubmitted < m_batch.size())
+	{
+		// Only the kernel advances the head, and only this backend advances the tail
+		unsigned int tail = *m_submissionTail;
+		unsigned int head = __atomic_load_n(m_submissionHead, __ATOMIC_ACQUIRE);
+		while ((numSubmitted < m_batch.size()) && (tail - head < m_numSubmissionEntries) && (m_numInFlight < m_queueDepth))
+		{
+			ChunkIORequest* request = m_batch[numSubmitted];
+			unsigned int index = tail & m_submissionMask;
+
+			io_uring_sqe& entry = m_submissionEntries[index];
+			memset(&entry, 0, sizeof(entry));
+			entry.opcode = (request->operation == ChunkIOOperationEnum::READ) ? IORING_OP_READ : IORING_OP_WRITE;
+			entry.fd = request->regionFile->GetFileDescriptor();
+			entry.off = request->offset;
+			entry.addr = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(request->data->data()));
+			entry.len = static_cast<uint32_t>(request->data->size());
+			entry.user_data = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(request));
+			m_submissionArray[index] = index;
+
+			++tail;
+			++m_numInFlight;
+			++numSubmitted;
+		}
+		__atomic_store_n(m_submissionTail, tail, __ATOMIC_RELEASE);
+
+		// Limiting the requests in flight to the queue depth keeps the completion queue from overflowing,
+		// so a full queue waits for a completion before placing more requests
+		unsigned int minCompletions = (numSubmitted < m_batch.size()) ? 1 : 0;
+		if (!Enter(minCompletions))
+		{
+			break;
+		}
+		ReapCompletions();
+	}
+
+	m_batch.erase(m_batch.begin(), m_batch.begin() + numSubmitted);
+}
+
+/**
+ * @brief Invokes the callbacks of the requests that completed since the last call, then deletes the requests
+ */
+void IoUringChunkIO::PollCompletions()
+{
+	ReapCompletions();
+
+	// Callbacks may enqueue new requests, so the completed requests are moved out first
+	std::vector<ChunkIORequest*> completedRequests;
+	completedRequests.swap(m_completedRequests);
+	for (size_t i = 0; i < completedRequests.size(); ++i)
+	{
+		ChunkIORequest* request = completedRequests[i];
+		RecordCompletion(*request);
+		if (request->callback)
+		{
+			request->callback(*request);
+		}
+		delete request;
+	}
+}
+
+/**
+ * @brief Submits the enqueued requests and blocks until every request has completed.
+ * The callbacks are not invoked until the next call to PollCompletions().
+ */
+void IoUringChunkIO::WaitForAll()
+{
+	Submit();
+	while (m_numInFlight > 0)
+	{
+		if (!Enter(1))
+		{
+			std::cerr << "[IoUringChunkIO] Gave up waiting for " << m_numInFlight << " requests" << std::endl;
+			return;
+		}
+		ReapCompletions();
+	}
+}
+
+/**
+ * @brief Submits the entries placed in the submission queue, optionally waiting for completions
+ * @param[in] minCompletions Number of completions to wait for
+ * @return True if the kernel accepted the call
+ */
+bool IoUringChunkIO::Enter(const unsigned int& minCompletions)
+{
+	while (true)
+	{
+		unsigned int numToSubmit = *m_submissionTail - __atomic_load_n(m_submissionHead, __ATOMIC_ACQUIRE);
+		if ((numToSubmit == 0) && (minCompletions == 0))
+		{
+			return true;
+		}
+
+		unsigned int flags = (minCompletions > 0) ? IORING_ENTER_GETEVENTS : 0;
+		long result = syscall(__NR_io_uring_enter, m_ringFileDescriptor, numToSubmit, minCompletions, flags, nullptr, 0);
+		if (result >= 0)
+		{
+			return true;
+		}
+
+		if (errno == EINTR)
+		{
+			continue;
+		}
+
+		// The kernel is temporarily out of resources. The entries stay queued and are submitted on the next call.
+		if (((errno == EAGAIN) || (errno == EBUSY)) && (minCompletions == 0))
+		{
+			return true;
+		}
+
+		std::cerr << "[IoUringChunkIO] io_uring_enter failed with error " << errno << std::endl;
+		return false;
+	}
+}
+
+/**
+ * @brief Takes the available entries from the completion queue and moves their requests to the completed requests
+ */
+void IoUringChunkIO::ReapCompletions()
+{
+	// Only this backend advances the head, and only the kernel advances the tail
+	unsigned int head = *m_completionHead;
+	unsigned int tail = __atomic_load_n(m_completionTail, __ATOMIC_ACQUIRE);
+	while (head != tail)
+	{
+		const io_uring_cqe& entry = m_completionEntries[head & m_completionMask];
+		ChunkIORequest* request = reinterpret_cast<ChunkIORequest*>(static_cast<uintptr_t>(entry.user_data));
+
+		// Regular files rarely transfer fewer bytes than requested, so the rest is transferred right away
+		std::vector<uint8_t>& data = *request->data;
+		size_t numBytesTransferred = (entry.res > 0) ? static_cast<size_t>(entry.res) : 0;
+		if (entry.res < 0)
+		{
+			request->succeeded = false;
+		}
+		else if (numBytesTransferred >= data.size())
+		{
+			request->succeeded = true;
+		}
+		else if (request->operation == ChunkIOOperationEnum::READ)
+		{
+			request->succeeded = request->regionFile->ReadAt(request->offset + numBytesTransferred, data.data() + numBytesTransferred, data.size() - numBytesTransferred);
+		}
+		else
+		{
+			request->succeeded = request->regionFile->WriteAt(request->offset + numBytesTransferred, data.data() + numBytesTransferred, data.size() - numBytesTransferred);
+		}
+
+		m_completedRequests.push_back(request);
+		--m_numInFlight;
+		++head;
+	}
+	__atomic_store_n(m_completionHead, head, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Releases the mapped rings and closes the io_uring instance
+ */
+void IoUringChunkIO::Destroy()
+{
+	if (m_submissionEntries != nullptr)
+	{
+		munmap(m_submissionEntries, m_numSubmissionEntries * sizeof(io_uring_sqe));
+		m_submissionEntries = nullptr;
+	}
+
+	if ((m_completionRing != nullptr) && (m_completionRing != m_submissionRing))
+	{
+		munmap(m_completionRing, m_completionRingSize);
+	}
+	m_completionRing = nullptr;
+
+	if (m_submissionRing != nullptr)
+	{
+		munmap(m_submissionRing, m_submissionRingSize);
+		m_submissionRing = nullptr;
+	}
+
+	if (m_ringFileDescriptor >= 0)
+	{
+		close(m_ringFileDescriptor);
+		m_ringFileDescriptor = -1;
+	}
+}
+
+#endif
@@ -0,0 +1,163 @@
+#include "IO/ThreadPoolChunkIO.hpp"
+
+/**
+ * @brief Constructor. Starts the worker threads.
+ * @param[in] numThreads Number of worker threads
+ */
+ThreadPoolChunkIO::ThreadPoolChunkIO(const size_t& numThreads)
+	: BaseChunkIO()
+	, m_batch()
+	, m_queuedRequests()
+	, m_completedRequests()
+	, m_numInFlight(0)
+	, m_isStopping(false)
+	, m_mutex()
+	, m_workAvailable()
+	, m_allCompleted()
+	, m_threads()
+{
+	for (size_t i = 0; i < numThreads; ++i)
+	{
+		m_threads.push_back(std::thread(&ThreadPoolChunkIO::Run, this));
+	}
+}
+
+/**
+ * @brief Destructor. Waits for the submitted requests, then stops the worker threads.
+ * Callbacks of requests that were not polled yet are not invoked.
+ */
+ThreadPoolChunkIO::~ThreadPoolChunkIO()
+{
+	WaitForAll();
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_isStopping = true;
+	}
+	m_workAvailable.notify_all();
+
+	for (size_t i = 0; i < m_threads.size(); ++i)
+	{
+		m_threads[i].join();
+	}
+	m_threads.clear();
+
+	for (size_t i = 0; i < m_completedRequests.size(); ++i)
+	{
+		delete m_completedRequests[i];
+	}
+	m_completedRequests.clear();
+}
+
+/**
+ * @brief Gets the type of this backend
+ * @return Backend type
+ */
+ChunkIOBackendEnum ThreadPoolChunkIO::GetBackendType() const
+{
+	return ChunkIOBackendEnum::THREAD_POOL;
+}
+
+/**
+ * @brief Adds the request to the batch that is handed to the backend on the next call to Submit()
+ * @param[in] request Request to add. The backend takes ownership of the request.
+ */
+void ThreadPoolChunkIO::Enqueue(ChunkIORequest* request)
+{
+	request->succeeded = false;
+	m_batch.push_back(request);
+	++m_numPendingRequests;
+}
+
+/**
+ * @brief Hands every enqueued request to the worker threads
+ */
+void ThreadPoolChunkIO::Submit()
+{
+	if (m_batch.empty())
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_queuedRequests.insert(m_queuedRequests.end(), m_batch.begin(), m_batch.end());
+		m_numInFlight += m_batch.size();
+	}
+	m_batch.clear();
+	m_workAvailable.notify_all();
+}
+
+/**
+ * @brief Invokes the callbacks of the requests that completed since the last call, then deletes the requests
+ */
+void ThreadPoolChunkIO::PollCompletions()
+{
+	std::vector<ChunkIORequest*> completedRequests;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		completedRequests.swap(m_completedRequests);
+	}
+
+	// Callbacks may enqueue new requests, so they run without holding the lock
+	for (size_t i = 0; i < completedRequests.size(); ++i)
+	{
+		ChunkIORequest* request = completedRequests[i];
+		RecordCompletion(*request);
+		if (request->callback)
+		{
+			request->callback(*request);
+		}
+		delete request;
+	}
+}
+
+/**
+ * @brief Submits the enqueued requests and blocks until every request has completed.
+ * The callbacks are not invoked until the next call to PollCompletions().
+ */
+void ThreadPoolChunkIO::WaitForAll()
+{
+	Submit();
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_allCompleted.wait(lock, [this]() { return m_numInFlight == 0; });
+}
+
+/**
+ * @brief Performs queued requests until the backend is stopped
+ */
+void ThreadPoolChunkIO::Run()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (true)
+	{
+		m_workAvailable.wait(lock, [this]() { return m_isStopping || !m_queuedRequests.empty(); });
+		if (m_queuedRequests.empty())
+		{
+			break;
+		}
+
+		ChunkIORequest* request = m_queuedRequests.front();
+		m_queuedRequests.pop_front();
+		lock.unlock();
+
+		std::vector<uint8_t>& data = *request->data;
+		if (request->operation == ChunkIOOperationEnum::READ)
+		{
+			request->succeeded = request->regionFile->ReadAt(request->offset, data.data(), data.size());
+		}
+		else
+		{
+			request->succeeded = request->regionFile->WriteAt(request->offset, data.data(), data.size());
+		}
+
+		lock.lock();
+		m_completedRequests.push_back(request);
+		--m_numInFlight;
+		if (m_numInFlight == 0)
+		{
+			m_allCompleted.notify_all();
+		}
+	}
+}
@@ -0,0 +1,58 @@
+#include "Jobs/Job.hpp"
+
+/**
+ * @brief Constructor
+ * @param[in] function Work done by the job
+ * @param[in] affinity Thread the job has to run on
+ */
+Job::Job(const std::function<void()>& function, const JobAffinityEnum& affinity)
+	: m_function(function)
+	, m_affinity(affinity)
+	, m_numPendingDependencies(1)
+	, m_dependents()
+	, m_isCompleted(false)
+	, m_mutex()
+{
+}
+
+/**
+ * @brief Destructor
+ */
+Job::~Job()
+{
+}
+
+/**
+ * @brief Makes this job wait until the provided job has completed.
+ * Should be called before this job is submitted. The dependency has to be submitted as well, or this job never runs.
+ * @param[in] dependency Job that has to complete first
+ */
+void Job::DependOn(const std::shared_ptr<Job>& dependency)
+{
+	std::lock_guard<std::mutex> lock(dependency->m_mutex);
+	if (dependency->m_isCompleted)
+	{
+		return;
+	}
+
+	++m_numPendingDependencies;
+	dependency->m_dependents.push_back(shared_from_this());
+}
+
+/**
+ * @brief Gets the thread the job has to run on
+ * @return Job affinity
+ */
+JobAffinityEnum Job::GetAffinity() const
+{
+	return m_affinity;
+}
+
+/**
+ * @brief Checks whether the job has run
+ * @return True if the job has completed
+ */
+bool Job::IsCompleted() const
+{
+	return m_isCompleted;
+}
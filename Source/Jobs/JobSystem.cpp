@@ -0,0 +1,322 @@
+#include "Jobs/JobSystem.hpp"
+
+#include <chrono>
+
+namespace
+{
+	/**
+	 * Job system the calling thread is a worker thread of. nullptr on every other thread.
+	 */
+	thread_local const JobSystem* t_workerJobSystem = nullptr;
+
+	/**
+	 * Index of the calling worker thread within its job system
+	 */
+	thread_local size_t t_workerIndex = 0;
+}
+
+/**
+ * @brief Constructor. Starts the worker threads.
+ * @param[in] numThreads Number of worker threads. If 0, no thread is started and every job runs on the main thread.
+ */
+JobSystem::JobSystem(const size_t& numThreads)
+	: m_workerQueues()
+	, m_mainThreadQueue()
+	, m_submittedQueue()
+	, m_numQueuedJobs(0)
+	, m_numUnfinishedJobs(0)
+	, m_isStopping(false)
+	, m_numExecutedJobs(0)
+	, m_numStolenJobs(0)
+	, m_totalIdleTime(0)
+	, m_mutex()
+	, m_workAvailable()
+	, m_allCompleted()
+	, m_threads()
+{
+	for (size_t i = 0; i < numThreads; ++i)
+	{
+		m_workerQueues.push_back(new WorkStealingQueue());
+	}
+
+	// Every queue exists before any thread starts stealing
+	for (size_t i = 0; i < numThreads; ++i)
+	{
+		m_threads.push_back(std::thread(&JobSystem::Run, this, i));
+	}
+}
+
+/**
+ * @brief Destructor. Waits for the submitted jobs, then stops the worker threads.
+ */
+JobSystem::~JobSystem()
+{
+	WaitForAll();
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_isStopping = true;
+	}
+	m_workAvailable.notify_all();
+
+	for (size_t i = 0; i < m_threads.size(); ++i)
+	{
+		m_threads[i].join();
+	}
+	m_threads.clear();
+
+	for (size_t i = 0; i < m_workerQueues.size(); ++i)
+	{
+		delete m_workerQueues[i];
+	}
+	m_workerQueues.clear();
+}
+
+/**
+ * @brief Hands the job over to the job system. It runs once every job it depends on has completed.
+ * @param[in] job Job to run
+ */
+void JobSystem::Submit(const std::shared_ptr<Job>& job)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		++m_numUnfinishedJobs;
+	}
+
+	// Releases the reference that kept the job from being scheduled while its dependencies were added
+	if (--job->m_numPendingDependencies == 0)
+	{
+		Schedule(job);
+	}
+}
+
+/**
+ * @brief Runs the ready jobs that have to run on the main thread, oldest first,
+ * including the ones that become ready while running them
+ * @return Number of jobs that were run
+ */
+size_t JobSystem::RunMainThreadJobs()
+{
+	size_t ret = 0;
+	std::shared_ptr<Job> job;
+	while (m_mainThreadQueue.Steal(job))
+	{
+		Execute(job);
+		++ret;
+	}
+	return ret;
+}
+
+/**
+ * @brief Blocks until every submitted job has completed, running the main thread jobs as they become ready
+ */
+void JobSystem::WaitForAll()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (m_numUnfinishedJobs > 0)
+	{
+		if (m_mainThreadQueue.GetSize() > 0)
+		{
+			lock.unlock();
+			RunMainThreadJobs();
+			lock.lock();
+			continue;
+		}
+
+		m_allCompleted.wait(lock);
+	}
+}
+
+/**
+ * @brief Gets the number of worker threads
+ * @return Number of worker threads
+ */
+size_t JobSystem::GetWorkerCount() const
+{
+	return m_threads.size();
+}
+
+/**
+ * @brief Gets the number of submitted jobs that have not completed yet, including jobs waiting for their dependencies
+ * @return Number of unfinished jobs
+ */
+size_t JobSystem::GetUnfinishedJobCount() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_numUnfinishedJobs;
+}
+
+/**
+ * @brief Gets the number of ready jobs waiting for a worker thread
+ * @return Combined depth of the worker queues and the queue of submitted jobs
+ */
+size_t JobSystem::GetQueuedJobCount() const
+{
+	return m_numQueuedJobs;
+}
+
+/**
+ * @brief Gets the number of ready jobs waiting for the main thread
+ * @return Depth of the main thread queue
+ */
+size_t JobSystem::GetMainThreadQueuedJobCount() const
+{
+	return m_mainThreadQueue.GetSize();
+}
+
+/**
+ * @brief Gets the number of jobs that have run
+ * @return Number of executed jobs
+ */
+uint64_t JobSystem::GetExecutedJobCount() const
+{
+	return m_numExecutedJobs;
+}
+
+/**
+ * @brief Gets the number of jobs that a worker thread took from the queue of another worker thread
+ * @return Number of steals
+ */
+uint64_t JobSystem::GetStealCount() const
+{
+	return m_numStolenJobs;
+}
+
+/**
+ * @brief Gets the time the worker threads spent waiting for work, added up over every worker thread
+ * @return Idle time in seconds
+ */
+float JobSystem::GetIdleTime() const
+{
+	return static_cast<float>(m_totalIdleTime * 1e-6);
+}
+
+/**
+ * @brief Adds a job whose dependencies have completed to the queue it runs from
+ * @param[in] job Ready job
+ */
+void JobSystem::Schedule(const std::shared_ptr<Job>& job)
+{
+	// Without worker threads, the main thread runs every job
+	if ((job->GetAffinity() == JobAffinityEnum::MAIN_THREAD) || m_workerQueues.empty())
+	{
+		m_mainThreadQueue.Push(job);
+
+		// Taking the lock makes sure a main thread about to wait in WaitForAll() sees the job
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+		}
+		m_allCompleted.notify_all();
+		return;
+	}
+
+	// Counting the job before it is pushed keeps the count from dropping below zero when it gets taken right away
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		++m_numQueuedJobs;
+	}
+
+	// Jobs made ready by a worker thread stay on that thread, while its data is still in the cache
+	if (t_workerJobSystem == this)
+	{
+		m_workerQueues[t_workerIndex]->Push(job);
+	}
+	else
+	{
+		m_submittedQueue.Push(job);
+	}
+	m_workAvailable.notify_one();
+}
+
+/**
+ * @brief Takes a ready job from the queue of the worker thread, then from the submitted jobs, or steals one from another worker thread
+ * @param[in] workerIndex Index of the worker thread
+ * @param[out] job Taken job
+ * @return True if a job was taken
+ */
+bool JobSystem::TakeJob(const size_t& workerIndex, std::shared_ptr<Job>& job)
+{
+	if (m_workerQueues[workerIndex]->Pop(job) || m_submittedQueue.Steal(job))
+	{
+		--m_numQueuedJobs;
+		return true;
+	}
+
+	for (size_t i = 1; i < m_workerQueues.size(); ++i)
+	{
+		if (m_workerQueues[(workerIndex + i) % m_workerQueues.size()]->Steal(job))
+		{
+			--m_numQueuedJobs;
+			++m_numStolenJobs;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * @brief Runs the job, then schedules the dependents whose last dependency it was
+ * @param[in] job Job to run
+ */
+void JobSystem::Execute(const std::shared_ptr<Job>& job)
+{
+	job->m_function();
+	job->m_function = nullptr;
+
+	std::vector<std::shared_ptr<Job>> dependents;
+	{
+		std::lock_guard<std::mutex> lock(job->m_mutex);
+		job->m_isCompleted = true;
+		dependents.swap(job->m_dependents);
+	}
+
+	for (size_t i = 0; i < dependents.size(); ++i)
+	{
+		if (--dependents[i]->m_numPendingDependencies == 0)
+		{
+			Schedule(dependents[i]);
+		}
+	}
+
+	++m_numExecutedJobs;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	--m_numUnfinishedJobs;
+	if (m_numUnfinishedJobs == 0)
+	{
+		m_allCompleted.notify_all();
+	}
+}
+
+/**
+ * @brief Runs jobs until the job system is stopped
+ * @param[in] workerIndex Index of the worker thread
+ */
+void JobSystem::Run(const size_t& workerIndex)
+{
+	t_workerJobSystem = this;
+	t_workerIndex = workerIndex;
+
+	while (true)
+	{
+		std::shared_ptr<Job> job;
+		if (TakeJob(workerIndex, job))
+		{
+			Execute(job);
+			continue;
+		}
+
+		std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_workAvailable.wait(lock, [this]() { return m_isStopping || (m_numQueuedJobs > 0); });
+			if (m_numQueuedJobs == 0)
+			{
+				break;
+			}
+		}
+		std::chrono::duration<double, std::micro> idleTime = std::chrono::steady_clock::now() - startTime;
+		m_totalIdleTime += static_cast<uint64_t>(idleTime.count());
+	}
+}
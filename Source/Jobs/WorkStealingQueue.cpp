@@ -0,0 +1,87 @@
+#include "Jobs/WorkStealingQueue.hpp"
+
+/**
+ * @brief Constructor
+ */
+WorkStealingQueue::WorkStealingQueue()
+	: m_jobs()
+	, m_size(0)
+	, m_mutex()
+{
+}
+
+/**
+ * @brief Destructor
+ */
+WorkStealingQueue::~WorkStealingQueue()
+{
+}
+
+/**
+ * @brief Adds the job at the back of the queue
+ * @param[in] job Ready job
+ */
+void WorkStealingQueue::Push(const std::shared_ptr<Job>& job)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_jobs.push_back(job);
+	m_size = m_jobs.size();
+}
+
+/**
+ * @brief Takes the newest job from the back of the queue. Used by the owner of the queue.
+ * @param[out] job Taken job
+ * @return True if a job was taken, false if the queue is empty
+ */
+bool WorkStealingQueue::Pop(std::shared_ptr<Job>& job)
+{
+	// Checking the size first keeps idle owners from contending with thieves for the lock
+	if (m_size == 0)
+	{
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (m_jobs.empty())
+	{
+		return false;
+	}
+
+	job = m_jobs.back();
+	m_jobs.pop_back();
+	m_size = m_jobs.size();
+	return true;
+}
+
+/**
+ * @brief Takes the oldest job from the front of the queue. Used by threads other than the owner.
+ * @param[out] job Taken job
+ * @return True if a job was taken, false if the queue is empty
+ */
+bool WorkStealingQueue::Steal(std::shared_ptr<Job>& job)
+{
+	if (m_size == 0)
+	{
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (m_jobs.empty())
+	{
+		return false;
+	}
+
+	job = m_jobs.front();
+	m_jobs.pop_front();
+	m_size = m_jobs.size();
+	return true;
+}
+
+/**
+ * @brief Gets the number of jobs in the queue. The value may be outdated by the time it is used.
+ * @return Number of queued jobs
+ */
+size_t WorkStealingQueue::GetSize() const
+{
+	return m_size;
+}
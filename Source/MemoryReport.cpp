@@ -0,0 +1,35 @@
+#include "MemoryReport.hpp"
+
+/**
+ * @brief Constructor. Every count starts at zero.
+ */
+MemoryUsage::MemoryUsage()
+	: blockStorageBytes(0)
+	, cpuMeshBytes(0)
+	, gpuBufferBytes(0)
+	, bookkeepingBytes(0)
+{
+}
+
+/**
+ * @brief Gets the total number of bytes across every subsystem
+ * @return Total bytes
+ */
+size_t MemoryUsage::GetTotal() const
+{
+	return blockStorageBytes + cpuMeshBytes + gpuBufferBytes + bookkeepingBytes;
+}
+
+/**
+ * @brief Adds the counts of another breakdown to this one
+ * @param[in] other Breakdown to add
+ * @return This breakdown
+ */
+MemoryUsage& MemoryUsage::operator+=(const MemoryUsage& other)
+{
+	blockStorageBytes += other.blockStorageBytes;
+	cpuMeshBytes += other.cpuMeshBytes;
+	gpuBufferBytes += other.gpuBufferBytes;
+	bookkeepingBytes += other.bookkeepingBytes;
+	return *this;
+}
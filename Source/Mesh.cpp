@@ -12,6 +12,8 @@ Mesh::Mesh()
 	, ebo(0)
 	, vertices()
 	, indices()
+	, vertexBufferSize(0)
+	, indexBufferSize(0)
 {
 }
 
@@ -19,6 +21,15 @@ Mesh::Mesh()
  * @brief Destructor
  */
 Mesh::~Mesh()
+{
+	Release();
+}
+
+/**
+ * @brief Deletes the GPU buffers and frees the vertex and index lists.
+ * The mesh can be filled and uploaded again afterwards.
+ */
+void Mesh::Release()
 {
 	if (vbo != 0)
 	{
@@ -37,6 +48,116 @@ Mesh::~Mesh()
 		glDeleteVertexArrays(1, &vao);
 		vao = 0;
 	}
+
+	vertexBufferSize = 0;
+	indexBufferSize = 0;
+
+	std::vector<Vertex>().swap(vertices);
+	std::vector<GLuint>().swap(indices);
+}
+
+/**
+ * @brief Hands the GPU buffers over to the deletion queue instead of deleting them right away.
+ * The vertex and index lists are kept, so the mesh can be destroyed on any thread afterwards.
+ * @param[in] deletionQueue Queue that deletes the buffers on the render thread
+ */
+void Mesh::DeferBufferDeletion(GLDeletionQueue& deletionQueue)
+{
+	deletionQueue.EnqueueBuffer(vbo);
+	deletionQueue.EnqueueBuffer(ebo);
+	deletionQueue.EnqueueVertexArray(vao);
+	vbo = 0;
+	ebo = 0;
+	vao = 0;
+
+	vertexBufferSize = 0;
+	indexBufferSize = 0;
+}
+
+/**
+ * @brief Checks whether the mesh has been uploaded to the GPU
+ * @return True if the mesh has GPU buffers
+ */
+bool Mesh::IsUploaded() const
+{
+	return vao != 0;
+}
+
+/**
+ * @brief Gets the number of bytes allocated for the vertex and index lists
+ * @return CPU memory usage in bytes
+ */
+size_t Mesh::GetCPUMemoryUsage() const
+{
+	return vertices.capacity() * sizeof(Vertex) + indices.capacity() * sizeof(GLuint);
+}
+
+/**
+ * @brief Gets the number of bytes allocated for the GPU buffers
+ * @return GPU memory usage in bytes
+ */
+size_t Mesh::GetGPUMemoryUsage() const
+{
+	return vertexBufferSize + indexBufferSize;
+}
+
+/**
+ * @brief Uploads the vertex and index lists to the GPU.
+ * Existing buffers are reused if they are large enough.
+ */
+void Mesh::Upload()
+{
+	if (vao == 0)
+	{
+		glGenVertexArrays(1, &vao);
+	}
+	glBindVertexArray(vao);
+
+	if (vbo == 0)
+	{
+		glGenBuffers(1, &vbo);
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	size_t vertexDataSize = sizeof(Vertex) * vertices.size();
+	if (vertexDataSize > vertexBufferSize)
+	{
+		glBufferData(GL_ARRAY_BUFFER, vertexDataSize, vertices.data(), GL_DYNAMIC_DRAW);
+		vertexBufferSize = vertexDataSize;
+	}
+	else if (vertexDataSize > 0)
+	{
+		glBufferSubData(GL_ARRAY_BUFFER, 0, vertexDataSize, vertices.data());
+	}
+
+	if (ebo == 0)
+	{
+		glGenBuffers(1, &ebo);
+	}
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+	size_t indexDataSize = sizeof(GLuint) * indices.size();
+	if (indexDataSize > indexBufferSize)
+	{
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexDataSize, indices.data(), GL_DYNAMIC_DRAW);
+		indexBufferSize = indexDataSize;
+	}
+	else if (indexDataSize > 0)
+	{
+		glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, indexDataSize, indices.data());
+	}
+
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, position)));
+
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, color)));
+
+	glEnableVertexAttribArray(2);
+	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, uv)));
+
+	glEnableVertexAttribArray(3);
+	glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, normal)));
+
+	glBindVertexArray(0);
 }
 
 /**
@@ -0,0 +1,518 @@
+#include "RegionFile.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	/**
+	 * File signature of region files
+	 */
+	const char REGION_FILE_MAGIC[4] = { 'P', 'G', 'W', 'R' };
+
+	/**
+	 * Current version of the region file format
+	 */
+	const uint32_t REGION_FILE_FORMAT_VERSION = 3;
+
+	/**
+	 * Number of pages the file grows by at least when it runs out of space
+	 */
+	const size_t REGION_FILE_GROWTH_PAGES = 64;
+
+	/**
+	 * @brief Gets the number of pages needed to hold the specified number of bytes
+	 * @param[in] size Number of bytes
+	 * @return Number of pages
+	 */
+	size_t GetPageCount(const size_t& size)
+	{
+		return (size + Constants::REGION_PAGE_SIZE - 1) / Constants::REGION_PAGE_SIZE;
+	}
+}
+
+/**
+ * @brief Constructor
+ */
+RegionFile::RegionFile()
+	: m_filePath()
+#ifdef _WIN32
+	, m_fileHandle(INVALID_HANDLE_VALUE)
+	, m_mappingHandle(nullptr)
+#else
+	, m_fileDescriptor(-1)
+#endif
+	, m_mappedData(nullptr)
+	, m_mappedSize(0)
+{
+}
+
+/**
+ * @brief Destructor
+ */
+RegionFile::~RegionFile()
+{
+	Close();
+}
+
+/**
+ * @brief Opens the region file, creating it if it does not exist yet
+ * @param[in] filePath Path to the file
+ * @return True if the file was opened, false if it could not be opened or is not a valid region file
+ */
+bool RegionFile::Open(const std::string& filePath)
+{
+	Close();
+	m_filePath = filePath;
+
+	size_t fileSize = 0;
+#ifdef _WIN32
+	m_fileHandle = CreateFileA(filePath.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	LARGE_INTEGER largeFileSize;
+	if ((m_fileHandle == INVALID_HANDLE_VALUE) || !GetFileSizeEx(m_fileHandle, &largeFileSize))
+	{
+		std::cerr << "[RegionFile] Failed to open " << filePath << std::endl;
+		Close();
+		return false;
+	}
+	fileSize = static_cast<size_t>(largeFileSize.QuadPart);
+#else
+	m_fileDescriptor = open(filePath.c_str(), O_RDWR | O_CREAT, 0644);
+	struct stat fileStat;
+	if ((m_fileDescriptor < 0) || (fstat(m_fileDescriptor, &fileStat) != 0))
+	{
+		std::cerr << "[RegionFile] Failed to open " << filePath << std::endl;
+		Close();
+		return false;
+	}
+	fileSize = static_cast<size_t>(fileStat.st_size);
+#endif
+
+	bool isNewFile = fileSize == 0;
+	if (isNewFile)
+	{
+		fileSize = FIRST_DATA_PAGE * Constants::REGION_PAGE_SIZE;
+	}
+
+	if ((fileSize < FIRST_DATA_PAGE * Constants::REGION_PAGE_SIZE) || !Remap(fileSize))
+	{
+		std::cerr << "[RegionFile] Failed to map " << filePath << std::endl;
+		Close();
+		return false;
+	}
+
+	Header* header = GetHeader();
+	if (isNewFile)
+	{
+		// The offset table is already zeroed out by the resize, so every chunk starts out unsaved
+		memcpy(header->magic, REGION_FILE_MAGIC, sizeof(REGION_FILE_MAGIC));
+		header->formatVersion = REGION_FILE_FORMAT_VERSION;
+		header->numUsedPages = FIRST_DATA_PAGE;
+	}
+	else if ((memcmp(header->magic, REGION_FILE_MAGIC, sizeof(REGION_FILE_MAGIC)) != 0)
+		|| (header->formatVersion != REGION_FILE_FORMAT_VERSION)
+		|| (header->numUsedPages < FIRST_DATA_PAGE)
+		|| (header->numUsedPages > m_mappedSize / Constants::REGION_PAGE_SIZE))
+	{
+		std::cerr << "[RegionFile] " << filePath << " is not a valid region file" << std::endl;
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * @brief Flushes and closes the region file
+ */
+void RegionFile::Close()
+{
+	Flush();
+	Unmap();
+
+#ifdef _WIN32
+	if (m_fileHandle != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(m_fileHandle);
+		m_fileHandle = INVALID_HANDLE_VALUE;
+	}
+#else
+	if (m_fileDescriptor >= 0)
+	{
+		close(m_fileDescriptor);
+		m_fileDescriptor = -1;
+	}
+#endif
+}
+
+/**
+ * @brief Checks whether the region file is open
+ * @return True if the region file is open
+ */
+bool RegionFile::IsOpen() const
+{
+	return m_mappedData != nullptr;
+}
+
+/**
+ * @brief Gets a read-only view of the saved data of a chunk in the region.
+ * The view stays valid until the next call to WriteChunk(), ReserveChunk() or Close().
+ * @param[in] localX Chunk x-index within the region
+ * @param[in] localY Chunk y-index within the region
+ * @param[in] localZ Chunk z-index within the region
+ * @param[out] data Start of the chunk data
+ * @param[out] size Size of the chunk data in bytes
+ * @return True if the chunk is saved in this region file
+ */
+bool RegionFile::ReadChunk(const int& localX, const int& localY, const int& localZ, const uint8_t*& data, size_t& size) const
+{
+	data = nullptr;
+	size = 0;
+
+	uint64_t offset = 0;
+	if (!LocateChunk(localX, localY, localZ, offset, size))
+	{
+		return false;
+	}
+
+	data = m_mappedData + offset;
+	return true;
+}
+
+/**
+ * @brief Saves the data of a chunk in the region, replacing any data previously saved for it
+ * @param[in] localX Chunk x-index within the region
+ * @param[in] localY Chunk y-index within the region
+ * @param[in] localZ Chunk z-index within the region
+ * @param[in] data Chunk data
+ * @param[in] size Size of the chunk data in bytes
+ * @return True if the data was written
+ */
+bool RegionFile::WriteChunk(const int& localX, const int& localY, const int& localZ, const uint8_t* data, const size_t& size)
+{
+	uint64_t offset = 0;
+	if (!ReserveChunk(localX, localY, localZ, size, offset))
+	{
+		return false;
+	}
+
+	memcpy(m_mappedData + offset, data, size);
+	return true;
+}
+
+/**
+ * @brief Gets where the saved data of a chunk is stored in the file, so that it can be read without going through the mapping
+ * @param[in] localX Chunk x-index within the region
+ * @param[in] localY Chunk y-index within the region
+ * @param[in] localZ Chunk z-index within the region
+ * @param[out] offset Offset of the chunk data from the start of the file in bytes
+ * @param[out] size Size of the chunk data in bytes
+ * @return True if the chunk is saved in this region file
+ */
+bool RegionFile::LocateChunk(const int& localX, const int& localY, const int& localZ, uint64_t& offset, size_t& size) const
+{
+	offset = 0;
+	size = 0;
+
+	if (!IsOpen() || (localX < 0) || (localX >= Constants::REGION_SIZE) || (localY < 0) || (localY >= Constants::REGION_SIZE)
+		|| (localZ < 0) || (localZ >= Constants::REGION_SIZE))
+	{
+		return false;
+	}
+
+	const ChunkEntry* entry = GetChunkEntry(localX, localY, localZ);
+	if (entry->firstPage == 0)
+	{
+		return false;
+	}
+
+	// Make sure the entry does not point outside of the used pages
+	size_t dataOffset = static_cast<size_t>(entry->firstPage) * Constants::REGION_PAGE_SIZE;
+	size_t usedSize = static_cast<size_t>(GetHeader()->numUsedPages) * Constants::REGION_PAGE_SIZE;
+	if ((entry->firstPage < FIRST_DATA_PAGE) || (entry->size == 0) || (dataOffset > usedSize) || (entry->size > usedSize - dataOffset))
+	{
+		std::cerr << "[RegionFile] Invalid entry for chunk " << localX << ", " << localY << ", " << localZ << " in " << m_filePath << std::endl;
+		return false;
+	}
+
+	offset = dataOffset;
+	size = entry->size;
+	return true;
+}
+
+/**
+ * @brief Allocates room for the data of a chunk and points its offset table entry at it, replacing any data previously saved for it.
+ * The caller has to write the data at the returned offset, for example with WriteAt(). Until then the entry points at stale data.
+ * @param[in] localX Chunk x-index within the region
+ * @param[in] localY Chunk y-index within the region
+ * @param[in] localZ Chunk z-index within the region
+ * @param[in] size Size of the chunk data in bytes
+ * @param[out] offset Offset from the start of the file where the chunk data should be written
+ * @return True if room was allocated
+ */
+bool RegionFile::ReserveChunk(const int& localX, const int& localY, const int& localZ, const size_t& size, uint64_t& offset)
+{
+	offset = 0;
+
+	if (!IsOpen() || (localX < 0) || (localX >= Constants::REGION_SIZE) || (localY < 0) || (localY >= Constants::REGION_SIZE)
+		|| (localZ < 0) || (localZ >= Constants::REGION_SIZE) || (size == 0) || (size > UINT32_MAX))
+	{
+		return false;
+	}
+
+	size_t numPages = GetPageCount(size);
+
+	// Overwrite the previous data in place if it fits, otherwise append the data after the used pages.
+	// Pages that are no longer referenced are not reused.
+	ChunkEntry* entry = GetChunkEntry(localX, localY, localZ);
+	uint32_t firstPage = entry->firstPage;
+	uint32_t numUsedPages = GetHeader()->numUsedPages;
+	bool fitsInPlace = (firstPage >= FIRST_DATA_PAGE) && (firstPage <= numUsedPages)
+		&& (GetPageCount(entry->size) >= numPages) && (GetPageCount(entry->size) <= numUsedPages - firstPage);
+	if (!fitsInPlace)
+	{
+		firstPage = numUsedPages;
+		size_t requiredSize = (static_cast<size_t>(firstPage) + numPages) * Constants::REGION_PAGE_SIZE;
+		if (requiredSize > m_mappedSize)
+		{
+			size_t grownSize = m_mappedSize + REGION_FILE_GROWTH_PAGES * Constants::REGION_PAGE_SIZE;
+			if (!Remap(requiredSize > grownSize ? requiredSize : grownSize))
+			{
+				std::cerr << "[RegionFile] Failed to grow " << m_filePath << std::endl;
+				return false;
+			}
+			entry = GetChunkEntry(localX, localY, localZ);
+		}
+		GetHeader()->numUsedPages = static_cast<uint32_t>(firstPage + numPages);
+	}
+
+	entry->size = static_cast<uint32_t>(size);
+	entry->firstPage = firstPage;
+	offset = static_cast<uint64_t>(firstPage) * Constants::REGION_PAGE_SIZE;
+	return true;
+}
+
+/**
+ * @brief Reads bytes from the file without going through the mapping. Can be called from any thread.
+ * @param[in] offset Offset from the start of the file in bytes
+ * @param[out] buffer Buffer receiving the bytes
+ * @param[in] size Number of bytes to read
+ * @return True if every byte was read
+ */
+bool RegionFile::ReadAt(const uint64_t& offset, uint8_t* buffer, const size_t& size) const
+{
+	size_t numBytesRead = 0;
+	while (numBytesRead < size)
+	{
+		uint64_t currentOffset = offset + numBytesRead;
+#ifdef _WIN32
+		OVERLAPPED overlapped = {};
+		overlapped.Offset = static_cast<DWORD>(currentOffset);
+		overlapped.OffsetHigh = static_cast<DWORD>(currentOffset >> 32);
+		DWORD chunkSize = static_cast<DWORD>(size - numBytesRead > MAXDWORD ? MAXDWORD : size - numBytesRead);
+		DWORD numBytes = 0;
+		if (!ReadFile(m_fileHandle, buffer + numBytesRead, chunkSize, &numBytes, &overlapped) || (numBytes == 0))
+		{
+			return false;
+		}
+#else
+		ssize_t numBytes = pread(m_fileDescriptor, buffer + numBytesRead, size - numBytesRead, static_cast<off_t>(currentOffset));
+		if ((numBytes < 0) && (errno == EINTR))
+		{
+			continue;
+		}
+		if (numBytes <= 0)
+		{
+			return false;
+		}
+#endif
+		numBytesRead += static_cast<size_t>(numBytes);
+	}
+
+	return true;
+}
+
+/**
+ * @brief Writes bytes to the file without going through the mapping. Can be called from any thread.
+ * The bytes should be within the room allocated by ReserveChunk().
+ * @param[in] offset Offset from the start of the file in bytes
+ * @param[in] data Bytes to write
+ * @param[in] size Number of bytes to write
+ * @return True if every byte was written
+ */
+bool RegionFile::WriteAt(const uint64_t& offset, const uint8_t* data, const size_t& size) const
+{
+	size_t numBytesWritten = 0;
+	while (numBytesWritten < size)
+	{
+		uint64_t currentOffset = offset + numBytesWritten;
+#ifdef _WIN32
+		OVERLAPPED overlapped = {};
+		overlapped.Offset = static_cast<DWORD>(currentOffset);
+		overlapped.OffsetHigh = static_cast<DWORD>(currentOffset >> 32);
+		DWORD chunkSize = static_cast<DWORD>(size - numBytesWritten > MAXDWORD ? MAXDWORD : size - numBytesWritten);
+		DWORD numBytes = 0;
+		if (!WriteFile(m_fileHandle, data + numBytesWritten, chunkSize, &numBytes, &overlapped) || (numBytes == 0))
+		{
+			return false;
+		}
+#else
+		ssize_t numBytes = pwrite(m_fileDescriptor, data + numBytesWritten, size - numBytesWritten, static_cast<off_t>(currentOffset));
+		if ((numBytes < 0) && (errno == EINTR))
+		{
+			continue;
+		}
+		if (numBytes <= 0)
+		{
+			return false;
+		}
+#endif
+		numBytesWritten += static_cast<size_t>(numBytes);
+	}
+
+	return true;
+}
+
+#ifndef _WIN32
+/**
+ * @brief Gets the descriptor of the opened file, used to submit reads and writes to the kernel directly
+ * @return File descriptor. Returns -1 if the file is not open.
+ */
+int RegionFile::GetFileDescriptor() const
+{
+	return m_fileDescriptor;
+}
+#endif
+
+/**
+ * @brief Writes modified pages back to the file
+ */
+void RegionFile::Flush()
+{
+	if (!IsOpen())
+	{
+		return;
+	}
+
+#ifdef _WIN32
+	FlushViewOfFile(m_mappedData, m_mappedSize);
+#else
+	msync(m_mappedData, m_mappedSize, MS_ASYNC);
+#endif
+}
+
+/**
+ * @brief Gets the number of bytes of the file mapped into memory
+ * @return Mapped size in bytes
+ */
+size_t RegionFile::GetMappedSize() const
+{
+	return m_mappedSize;
+}
+
+/**
+ * @brief Gets the header of the mapped file
+ * @return Header
+ */
+RegionFile::Header* RegionFile::GetHeader() const
+{
+	return reinterpret_cast<Header*>(m_mappedData);
+}
+
+/**
+ * @brief Gets the offset table entry of a chunk
+ * @param[in] localX Chunk x-index within the region
+ * @param[in] localY Chunk y-index within the region
+ * @param[in] localZ Chunk z-index within the region
+ * @return Offset table entry
+ */
+RegionFile::ChunkEntry* RegionFile::GetChunkEntry(const int& localX, const int& localY, const int& localZ) const
+{
+	ChunkEntry* offsetTable = reinterpret_cast<ChunkEntry*>(m_mappedData + OFFSET_TABLE_FIRST_PAGE * Constants::REGION_PAGE_SIZE);
+	return &offsetTable[(localY * Constants::REGION_SIZE + localZ) * Constants::REGION_SIZE + localX];
+}
+
+/**
+ * @brief Resizes the file and maps it again
+ * @param[in] newSize New file size in bytes
+ * @return True if the file was resized and mapped
+ */
+bool RegionFile::Remap(const size_t& newSize)
+{
+	Unmap();
+
+#ifdef _WIN32
+	LARGE_INTEGER largeNewSize;
+	largeNewSize.QuadPart = static_cast<LONGLONG>(newSize);
+	if (!SetFilePointerEx(m_fileHandle, largeNewSize, nullptr, FILE_BEGIN) || !SetEndOfFile(m_fileHandle))
+	{
+		return false;
+	}
+
+	m_mappingHandle = CreateFileMappingA(m_fileHandle, nullptr, PAGE_READWRITE, 0, 0, nullptr);
+	if (m_mappingHandle == nullptr)
+	{
+		return false;
+	}
+
+	void* mappedData = MapViewOfFile(m_mappingHandle, FILE_MAP_ALL_ACCESS, 0, 0, newSize);
+	if (mappedData == nullptr)
+	{
+		Unmap();
+		return false;
+	}
+#else
+	if (ftruncate(m_fileDescriptor, static_cast<off_t>(newSize)) != 0)
+	{
+		return false;
+	}
+
+	void* mappedData = mmap(nullptr, newSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fileDescriptor, 0);
+	if (mappedData == MAP_FAILED)
+	{
+		return false;
+	}
+#endif
+
+	m_mappedData = static_cast<uint8_t*>(mappedData);
+	m_mappedSize = newSize;
+	return true;
+}
+
+/**
+ * @brief Releases the mapping of the file, keeping the file open
+ */
+void RegionFile::Unmap()
+{
+#ifdef _WIN32
+	if (m_mappedData != nullptr)
+	{
+		UnmapViewOfFile(m_mappedData);
+	}
+	if (m_mappingHandle != nullptr)
+	{
+		CloseHandle(m_mappingHandle);
+		m_mappingHandle = nullptr;
+	}
+#else
+	if (m_mappedData != nullptr)
+	{
+		munmap(m_mappedData, m_mappedSize);
+	}
+#endif
+
+	m_mappedData = nullptr;
+	m_mappedSize = 0;
+}
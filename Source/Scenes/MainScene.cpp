@@ -9,6 +9,7 @@
 
 #include "Enums/BlockTypeEnum.hpp"
 #include "EntityTemplates/BlockTemplateManager.hpp"
+#include "Utils/CoordinateUtils.hpp"
 #include "Utils/MathUtils.hpp"
 #include "Window.hpp"
 #include "WindowManager.hpp"
@@ -32,6 +33,7 @@ MainScene::MainScene(SceneManager *sceneManager)
 	, m_world(nullptr)
 	, m_prevChunkIndices()
 	, m_chunkRenderDistance(8)
+	, m_chunkGenerationTimeBudget(4.0f)
 	, m_currentTime(0)
 	, m_timeTickTimer(0.0f)
 	, m_uiRenderer()
@@ -103,7 +105,9 @@ void MainScene::Init()
 	ResourceManager::GetInstance().CreateTexture("Resources/Textures/Moon.png", "moon");
 
 	// Create world data
-	m_world = new World();
+	// Use ChunkGenerationModeEnum::TIME_SLICED where worker threads are not available
+	m_world = new World(ChunkContainerTypeEnum::HASH_MAP, m_chunkRenderDistance, Constants::VERTICAL_LOAD_RADIUS, ChunkIOBackendEnum::IO_URING, 0,
+		ChunkGenerationModeEnum::JOB_SYSTEM);
 
 	WorldGenParams worldGenParams;
 	worldGenParams.worldSize = 1024;
@@ -116,11 +120,16 @@ void MainScene::Init()
 	worldGenParams.noiseLacunarity = 2.0f;
 	m_world->SetWorldGenParams(worldGenParams);
 
+	// Modified chunks are saved here when they get unloaded
+	m_world->SetSaveDirectory("Saves");
+
 	// Setup camera
 	m_camera.SetPosition({worldGenParams.worldSize / 2.0f, worldGenParams.worldMaxHeight + 1.0f, worldGenParams.worldSize / 2.0f});
 	m_camera.SetAspectRatio(800.0f / 600.0f);
 
-	// Generate initial chunks
+	// Generate initial chunks around the camera
+	m_prevChunkIndices = CoordinateUtils::WorldToChunkIndex(m_camera.GetPosition());
+	m_world->SetViewpoint(m_camera.GetPosition(), m_camera.GetForwardVector());
 	m_world->LoadChunksWithinArea(m_prevChunkIndices, m_chunkRenderDistance);
 
 	m_uiRenderer.Initialize(1000);
@@ -213,29 +222,35 @@ void MainScene::Update(const float &deltaTime)
 		m_camera.SetPosition(m_camera.GetPosition() + movement * movementSpeed * deltaTime);
 	}
 
-	int currentChunkX = static_cast<int>(glm::floor(m_camera.GetPosition().x / Constants::BLOCK_SIZE / Constants::CHUNK_WIDTH));
-	int currentChunkZ = static_cast<int>(glm::floor(m_camera.GetPosition().z / Constants::BLOCK_SIZE / Constants::CHUNK_DEPTH));
+	// Requested chunks in front of the camera are generated first
+	m_world->SetViewpoint(m_camera.GetPosition(), m_camera.GetForwardVector());
+	m_world->PollChunkIO();
+	m_world->GenerateChunksForTime(m_chunkGenerationTimeBudget);
 
-	if ((currentChunkX != m_prevChunkIndices.x) || (currentChunkZ != m_prevChunkIndices.z))
+	glm::ivec3 currentChunkIndices = CoordinateUtils::WorldToChunkIndex(m_camera.GetPosition());
+	if (currentChunkIndices != m_prevChunkIndices)
 	{
-		m_world->LoadChunksWithinArea(glm::ivec3(currentChunkX, 0, currentChunkZ), m_chunkRenderDistance);
-		m_world->UnloadChunksOutsideArea(glm::ivec3(currentChunkX, 0, currentChunkZ), m_chunkRenderDistance);
+		// Unload first so that the unloaded chunks can be reused for the newly loaded ones
+		m_world->UnloadChunksOutsideArea(currentChunkIndices, m_chunkRenderDistance);
+		m_world->LoadChunksWithinArea(currentChunkIndices, m_chunkRenderDistance);
 
-		m_prevChunkIndices.x = currentChunkX;
-		m_prevChunkIndices.z = currentChunkZ;
+		m_prevChunkIndices = currentChunkIndices;
 	}
 
 	Ray ray(m_camera.GetPosition(), m_camera.GetForwardVector());
-	Block* raycastBlock = m_world->Raycast(ray, 5.0f);
+	BlockHandle raycastBlock = m_world->Raycast(ray, 5.0f);
+
+	if (Input::IsKeyPressed(Input::Key::M))
+	{
+		m_world->DumpMemoryReport("MemoryReport.csv");
+	}
 
 	if (Input::IsMouseButtonPressed(Input::Button::LEFT_MOUSE))
 	{
-		if (raycastBlock != nullptr)
+		if (raycastBlock.IsValid())
 		{
-			glm::ivec3 blockPositionInChunk = raycastBlock->GetPositionInChunk();
-			Chunk* chunk = m_world->GetChunkAtWorldPosition(raycastBlock->GetPositionInWorld());
-			chunk->SetBlockAt(blockPositionInChunk.x, blockPositionInChunk.y, blockPositionInChunk.z, nullptr);
-			chunk->GenerateMesh();
+			raycastBlock.SetBlockType(BlockTypeEnum::AIR);
+			raycastBlock.chunk->GenerateMesh();
 		}
 	}
 }
@@ -253,6 +268,9 @@ void MainScene::FixedUpdate(const float &timestep)
  */
 void MainScene::Draw()
 {
+	// GL objects of chunks deleted during the update can only be deleted here, where the context is current
+	m_world->FlushDeferredDeletions();
+
 	glEnable(GL_DEPTH_TEST);
 
 	float sunLightStrength = 1.0f;
@@ -360,30 +378,74 @@ void MainScene::Draw()
 	
 	waterShader->Unuse();
 
-	int currentChunkX = static_cast<int>(glm::floor(m_camera.GetPosition().x / Constants::BLOCK_SIZE / Constants::CHUNK_WIDTH));
-	int currentChunkZ = static_cast<int>(glm::floor(m_camera.GetPosition().z / Constants::BLOCK_SIZE / Constants::CHUNK_DEPTH));
+	glm::ivec3 currentChunkIndices = CoordinateUtils::WorldToChunkIndex(m_camera.GetPosition());
 
 	std::cout << "Looking at direction: " << m_camera.GetForwardVector().x << "," << m_camera.GetForwardVector().y << "," << m_camera.GetForwardVector().z << std::endl;
 
 	std::stringstream displayStringStream;
-	displayStringStream << "Chunk: " << currentChunkX << "  " << currentChunkZ << std::endl;
+	displayStringStream << "Chunk: " << currentChunkIndices.x << "  " << currentChunkIndices.y << "  " << currentChunkIndices.z << std::endl;
 	displayStringStream << "Position: " << std::fixed << std::setprecision(2) << m_camera.GetPosition().x << "  " << m_camera.GetPosition().y << "  " << m_camera.GetPosition().z << std::endl;
 
-	Block* currentBlock = m_world->GetBlockAtWorldPosition(m_camera.GetPosition());
-	if (currentBlock != nullptr)
+	BlockHandle currentBlock = m_world->GetBlockAtWorldPosition(m_camera.GetPosition());
+	if (currentBlock.GetBlockType() != BlockTypeEnum::AIR)
 	{
-		glm::ivec3 currentBlockPosition = currentBlock->GetPositionInWorld();
+		glm::ivec3 currentBlockPosition = currentBlock.GetPositionInWorld();
 		displayStringStream << "Current block: " << currentBlockPosition.x << " " << currentBlockPosition.y << " " << currentBlockPosition.z << std::endl;
 	}
 
 	Ray ray(m_camera.GetPosition(), m_camera.GetForwardVector());
-	Block* raycastBlock = m_world->Raycast(ray, 5.0f);
-	if (raycastBlock != nullptr)
+	BlockHandle raycastBlock = m_world->Raycast(ray, 5.0f);
+	if (raycastBlock.IsValid())
 	{
-		glm::ivec3 raycastBlockPosition = raycastBlock->GetPositionInWorld();
+		glm::ivec3 raycastBlockPosition = raycastBlock.GetPositionInWorld();
 		displayStringStream << "Looking at block: " << raycastBlockPosition.x << " " << raycastBlockPosition.y << " " << raycastBlockPosition.z << std::endl;
 	}
 
+	size_t blockMemoryUsage = m_world->GetBlockMemoryUsage();
+	size_t numLoadedChunks = m_world->GetLoadedChunkCount();
+	displayStringStream << "Block memory: " << blockMemoryUsage / 1024 << " KB";
+	if (numLoadedChunks > 0)
+	{
+		displayStringStream << " (" << blockMemoryUsage / numLoadedChunks / 1024.0f << " KB per chunk)";
+	}
+	displayStringStream << std::endl;
+
+	const ChunkPool& chunkPool = m_world->GetChunkPool();
+	displayStringStream << "Chunk pool: " << chunkPool.GetPooledChunkCount() << " pooled, " << chunkPool.GetHitCount() << " hits, " << chunkPool.GetMissCount() << " misses" << std::endl;
+
+	const ChunkReclaimer& chunkReclaimer = m_world->GetChunkReclaimer();
+	displayStringStream << "Chunk reclaimer: " << chunkReclaimer.GetPendingCount() << " pending, " << chunkReclaimer.GetReclaimedCount() << " reclaimed" << std::endl;
+
+	const JobSystem& jobSystem = m_world->GetJobSystem();
+	displayStringStream << "Jobs: " << jobSystem.GetWorkerCount() << " workers, " << jobSystem.GetQueuedJobCount() << " queued, "
+		<< jobSystem.GetMainThreadQueuedJobCount() << " on main thread, " << jobSystem.GetExecutedJobCount() << " run, "
+		<< jobSystem.GetStealCount() << " stolen, " << std::setprecision(1) << jobSystem.GetIdleTime() << " s idle" << std::endl;
+
+	const BaseChunkIO& chunkIO = m_world->GetChunkIO();
+	displayStringStream << "Chunk I/O (" << (chunkIO.GetBackendType() == ChunkIOBackendEnum::IO_URING ? "io_uring" : "thread pool") << "): "
+		<< chunkIO.GetPendingCount() << " pending, " << chunkIO.GetReadCount() << " read, " << chunkIO.GetWriteCount() << " written, "
+		<< chunkIO.GetFailureCount() << " failed" << std::endl;
+
+	const ChunkCache& chunkCache = m_world->GetChunkCache();
+	displayStringStream << "Chunk cache: " << chunkCache.GetCachedChunkCount() << " cached, "
+		<< chunkCache.GetResidentBytes() / 1024 << " / " << chunkCache.GetBudget() / 1024 << " KB, "
+		<< std::setprecision(1) << chunkCache.GetHitRate() * 100.0f << "% hit rate" << std::endl;
+	displayStringStream << "Hibernated: " << chunkCache.GetHibernatedChunkCount() << " chunks, "
+		<< std::setprecision(1) << chunkCache.GetCompressionRatio() << "x compression, "
+		<< std::setprecision(2) << chunkCache.GetAverageRehydrationTime() << " ms avg / "
+		<< chunkCache.GetMaxRehydrationTime() << " ms max rehydration" << std::endl;
+	displayStringStream << "Shared sections: " << m_world->GetSharedSections().GetDeduplicatedSectionCount() << " deduplicated" << std::endl;
+
+	const char* chunkStateNames[] = { "requested", "generating", "generated", "meshing", "uploaded", "visible", "unloading" };
+	static_assert(sizeof(chunkStateNames) / sizeof(chunkStateNames[0]) == static_cast<size_t>(ChunkStateEnum::COUNT), "Every chunk state should have a name");
+	ChunkStateCounts chunkStateCounts = m_world->GetChunkStateCounts();
+	displayStringStream << "Chunk states:";
+	for (size_t i = 0; i < chunkStateCounts.size(); ++i)
+	{
+		displayStringStream << (i > 0 ? ", " : " ") << chunkStateCounts[i] << " " << chunkStateNames[i];
+	}
+	displayStringStream << std::endl;
+
 	ResourceManager::GetInstance().GetShader("main")->Unuse();
 
 	Window *mainWindow = WindowManager::GetMainWindow();
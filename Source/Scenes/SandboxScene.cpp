@@ -1,5 +1,6 @@
 #include "Scenes/SandboxScene.hpp"
 
+#include "Constants.hpp"
 #include "Input.hpp"
 #include "Utils/NoiseUtils.hpp"
 #include "Window.hpp"
@@ -8,7 +9,9 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <vector>
 
 /**
  * @brief Constructor
@@ -42,12 +45,13 @@ void SandboxScene::Init()
 {
     m_uiRenderer.Initialize(1000);
 
+    //m_noise.SetNoiseType(FastNoiseLite::NoiseType_Perlin);
+    m_noise.SetSeed(m_noiseSeed);
+    m_noise.SetFrequency(Constants::NOISE_FREQUENCY);
+
     UpdateNoiseImage();
     m_noiseTexture.CreateFromImage(m_noiseImage);
     std::cout << "Octaves: " << m_noiseNumOctaves << " persistence: " << m_noisePersistence << " lacunarity: " << m_noiseLacunarity << std::endl;
-
-    //m_noise.SetNoiseType(FastNoiseLite::NoiseType_Perlin);
-    m_noise.SetSeed(m_noiseSeed);
 }
 
 /**
@@ -106,6 +110,11 @@ void SandboxScene::Update(const float &deltaTime)
         updateNoise = true;
     }
 
+    if (Input::IsKeyPressed(Input::Key::B))
+    {
+        BenchmarkNoise();
+    }
+
     if (updateNoise)
     {
         UpdateNoiseImage();
@@ -158,11 +167,27 @@ void SandboxScene::Cleanup()
  */
 void SandboxScene::UpdateNoiseImage()
 {
+    std::vector<float> noiseValues(m_noiseImage.width * m_noiseImage.height);
+    NoiseUtils::GetOctaveNoiseGrid
+    (
+        m_noiseSeed,
+        Constants::NOISE_FREQUENCY,
+        0.0f,
+        0.0f,
+        m_noiseImage.width,
+        m_noiseImage.height,
+        m_noiseNumOctaves,
+        m_noiseScale,
+        m_noisePersistence,
+        m_noiseLacunarity,
+        noiseValues.data()
+    );
+
     for (size_t x = 0; x < m_noiseImage.width; ++x)
     {
         for (size_t y = 0; y < m_noiseImage.height; ++y)
         {
-            float noiseValue = NoiseUtils::GetOctaveNoise(m_noise, x, y, m_noiseNumOctaves, m_noiseScale, m_noisePersistence, m_noiseLacunarity);
+            float noiseValue = noiseValues[y * m_noiseImage.width + x];
             noiseValue = (noiseValue + 1.0f) / 2.0f;
 
             unsigned char red = 0, green = 0, blue = 0;
@@ -204,3 +229,56 @@ void SandboxScene::UpdateNoiseImage()
         }
     }
 }
+
+/**
+ * @brief Measures the throughput of the scalar and the batched noise over the noise image,
+ * and checks that both give the same values
+ */
+void SandboxScene::BenchmarkNoise()
+{
+    size_t width = m_noiseImage.width;
+    size_t height = m_noiseImage.height;
+    std::vector<float> scalarValues(width * height);
+    std::vector<float> batchedValues(width * height);
+
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    for (size_t y = 0; y < height; ++y)
+    {
+        for (size_t x = 0; x < width; ++x)
+        {
+            scalarValues[y * width + x] = NoiseUtils::GetOctaveNoise(m_noise, x, y, m_noiseNumOctaves, m_noiseScale, m_noisePersistence, m_noiseLacunarity);
+        }
+    }
+    std::chrono::duration<double> scalarTime = std::chrono::steady_clock::now() - startTime;
+
+    startTime = std::chrono::steady_clock::now();
+    NoiseUtils::GetOctaveNoiseGrid
+    (
+        m_noiseSeed,
+        Constants::NOISE_FREQUENCY,
+        0.0f,
+        0.0f,
+        width,
+        height,
+        m_noiseNumOctaves,
+        m_noiseScale,
+        m_noisePersistence,
+        m_noiseLacunarity,
+        batchedValues.data()
+    );
+    std::chrono::duration<double> batchedTime = std::chrono::steady_clock::now() - startTime;
+
+    size_t numMismatches = 0;
+    for (size_t i = 0; i < scalarValues.size(); ++i)
+    {
+        if (scalarValues[i] != batchedValues[i])
+        {
+            ++numMismatches;
+        }
+    }
+
+    double numSamples = static_cast<double>(width * height);
+    std::cout << "Noise samples/s - scalar: " << numSamples / scalarTime.count()
+        << " batched: " << numSamples / batchedTime.count()
+        << " mismatches: " << numMismatches << std::endl;
+}
@@ -0,0 +1,119 @@
+#include "SharedSectionTable.hpp"
+
+#include <cassert>
+
+/**
+ * @brief Constructor
+ */
+SharedSectionTable::SharedSectionTable()
+	: m_sections()
+	, m_numSectionsAfterPrune(0)
+	, m_numDeduplicatedSections(0)
+{
+}
+
+/**
+ * @brief Destructor
+ */
+SharedSectionTable::~SharedSectionTable()
+{
+}
+
+/**
+ * @brief Gets the registered section with the same block data as the provided section,
+ * registering the provided section if there is none
+ * @param[in] section Section to look up
+ * @return Registered section with the same content, or the provided section itself
+ */
+std::shared_ptr<ChunkSection> SharedSectionTable::Share(const std::shared_ptr<ChunkSection>& section)
+{
+	uint64_t hash = section->GetContentHash();
+
+	// Registered sections are never modified, so the content is only compared to rule out hash collisions
+	typedef std::unordered_multimap<uint64_t, std::weak_ptr<ChunkSection>>::iterator Iterator;
+	std::pair<Iterator, Iterator> range = m_sections.equal_range(hash);
+	for (Iterator it = range.first; it != range.second; ++it)
+	{
+		std::shared_ptr<ChunkSection> registeredSection = it->second.lock();
+		if (registeredSection == section)
+		{
+			return section;
+		}
+
+		assert((registeredSection == nullptr) || registeredSection->IsShared());
+		if ((registeredSection != nullptr) && registeredSection->HasSameContent(*section))
+		{
+			++m_numDeduplicatedSections;
+			return registeredSection;
+		}
+	}
+
+	section->MarkShared();
+	m_sections.insert(std::make_pair(hash, std::weak_ptr<ChunkSection>(section)));
+	if (m_sections.size() > 2 * m_numSectionsAfterPrune + 64)
+	{
+		Prune();
+	}
+
+	return section;
+}
+
+/**
+ * @brief Removes the entries of sections that were freed
+ */
+void SharedSectionTable::Prune()
+{
+	typedef std::unordered_multimap<uint64_t, std::weak_ptr<ChunkSection>>::iterator Iterator;
+	for (Iterator it = m_sections.begin(); it != m_sections.end();)
+	{
+		if (it->second.expired())
+		{
+			it = m_sections.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+
+	m_numSectionsAfterPrune = m_sections.size();
+}
+
+/**
+ * @brief Removes every entry
+ */
+void SharedSectionTable::Clear()
+{
+	m_sections.clear();
+	m_numSectionsAfterPrune = 0;
+}
+
+/**
+ * @brief Gets the number of registered sections, including ones that may have been freed since the last prune
+ * @return Number of entries
+ */
+size_t SharedSectionTable::GetEntryCount() const
+{
+	return m_sections.size();
+}
+
+/**
+ * @brief Gets the number of sections that were replaced by an identical registered section
+ * @return Number of deduplicated sections
+ */
+uint64_t SharedSectionTable::GetDeduplicatedSectionCount() const
+{
+	return m_numDeduplicatedSections;
+}
+
+/**
+ * @brief Gets the number of bytes used by the table itself, not counting the sections
+ * @return Memory usage in bytes
+ */
+size_t SharedSectionTable::GetMemoryUsage() const
+{
+	// Each node holds the key, the weak reference and a next pointer
+	return sizeof(SharedSectionTable)
+		+ m_sections.size() * (sizeof(uint64_t) + sizeof(std::weak_ptr<ChunkSection>) + sizeof(void*))
+		+ m_sections.bucket_count() * sizeof(void*);
+}
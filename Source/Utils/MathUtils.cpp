@@ -1,5 +1,9 @@
 #include "Utils/MathUtils.hpp"
 
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 /**
  * @brief Performs a linear interpolation between two float scalars
  * @param[in] a First scalar
@@ -28,3 +32,19 @@ glm::vec4 MathUtils::Lerp(const glm::vec4 &a, const glm::vec4 &b, const float &t
     ret.w = Lerp(a.w, b.w, t);
     return ret;
 }
+
+/**
+ * @brief Gets the index of the lowest set bit
+ * @param[in] value Value to check. Should not be 0.
+ * @return Number of trailing zero bits
+ */
+int MathUtils::CountTrailingZeros(const uint64_t &value)
+{
+#ifdef _MSC_VER
+    unsigned long index = 0;
+    _BitScanForward64(&index, value);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(value);
+#endif
+}
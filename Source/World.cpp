@@ -1,21 +1,102 @@
 #include "World.hpp"
 
+#include "ChunkContainers/HashMapChunkContainer.hpp"
+#include "ChunkContainers/RingBufferChunkContainer.hpp"
+#include "ChunkContainers/VectorChunkContainer.hpp"
 #include "Constants.hpp"
+#include "Enums/ChunkPayloadTypeEnum.hpp"
+#include "IO/IoUringChunkIO.hpp"
+#include "IO/ThreadPoolChunkIO.hpp"
 #include "Mesh.hpp"
 #include "ResourceManager.hpp"
+#include "Utils/CoordinateUtils.hpp"
 #include "Utils/NoiseUtils.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
+#include <fstream>
 #include <glm/gtc/type_ptr.hpp>
 #include <iostream>
+#include <limits>
+#include <sstream>
+#include <thread>
+
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+namespace
+{
+	/**
+	 * Chunk index offset of each neighbor, in the order of ChunkNeighborEnum
+	 */
+	const glm::ivec3 NEIGHBOR_OFFSETS[] =
+	{
+		glm::ivec3(1, 0, 0),
+		glm::ivec3(-1, 0, 0),
+		glm::ivec3(0, 1, 0),
+		glm::ivec3(0, -1, 0),
+		glm::ivec3(0, 0, 1),
+		glm::ivec3(0, 0, -1)
+	};
+
+	/**
+	 * @brief Gets the neighbor in the opposite direction
+	 * @param[in] neighbor Neighbor direction
+	 * @return Opposite neighbor direction
+	 */
+	ChunkNeighborEnum GetOppositeNeighbor(const ChunkNeighborEnum& neighbor)
+	{
+		// Opposite directions are stored next to each other
+		return static_cast<ChunkNeighborEnum>(static_cast<int>(neighbor) ^ 1);
+	}
+}
 
 /**
  * @brief Constructor
+ * @param[in] chunkContainerType Type of container used to look up chunks
+ * @param[in] maxLoadRadius Largest radius in chunks that will be passed to LoadChunksWithinArea().
+ * Only used to size the ring buffer container.
+ * @param[in] maxVerticalLoadRadius Largest vertical radius in chunks that will be passed to LoadChunksWithinArea().
+ * Only used to size the ring buffer container.
+ * @param[in] chunkIOBackend Backend used to read and write saved chunks. Falls back to the thread pool if io_uring is not available.
+ * @param[in] numWorkerThreads Number of job system threads generating and meshing new chunks.
+ * If 0, one thread is started for every core except the one running the main thread.
+ * @param[in] chunkGenerationMode Whether new chunks are generated on the job system threads or time-sliced on the main thread.
+ * No job system thread is started in time-sliced mode.
  */
-World::World()
+World::World(const ChunkContainerTypeEnum& chunkContainerType, const int& maxLoadRadius, const int& maxVerticalLoadRadius, const ChunkIOBackendEnum& chunkIOBackend,
+	const size_t& numWorkerThreads, const ChunkGenerationModeEnum& chunkGenerationMode)
 	: m_chunks()
-	, m_noiseEngine()
+	, m_chunkContainer(nullptr)
+	, m_chunkPool(Constants::MAX_POOLED_CHUNKS)
+	, m_chunkCache(Constants::CHUNK_CACHE_BUDGET)
+	, m_glDeletionQueue()
+	, m_chunkReclaimer()
+	, m_sharedSections()
 	, m_worldGenParams()
+	, m_saveDirectory()
+	, m_regionFiles()
+	, m_chunkIO(nullptr)
+	, m_pendingWrites()
+	, m_pendingLoads()
+	, m_failedLoads()
+	, m_numFailedReads()
+	, m_loadCenter(0)
+	, m_loadRadius(0)
+	, m_loadVerticalRadius(0)
+	, m_chunkGenerationMode(chunkGenerationMode)
+	, m_jobSystem(nullptr)
+	, m_chunkGenerations()
+	, m_queuedGenerations()
+	, m_isGenerationQueueDirty(false)
+	, m_viewPosition(0.0f)
+	, m_viewDirection(0.0f, 0.0f, -1.0f)
+	, m_generatingChunks()
+	, m_timeSlicedGeneration(nullptr)
 {
 	m_worldGenParams.worldSize = 1024;
 	m_worldGenParams.worldMaxHeight = 30;
@@ -25,6 +106,54 @@ World::World()
 	m_worldGenParams.noiseScale = 1.0f;
 	m_worldGenParams.noisePersistence = 1.0f;
 	m_worldGenParams.noiseLacunarity = 2.0f;
+
+	if (chunkContainerType == ChunkContainerTypeEnum::VECTOR)
+	{
+		m_chunkContainer = new VectorChunkContainer();
+	}
+	else if (chunkContainerType == ChunkContainerTypeEnum::RING_BUFFER)
+	{
+		m_chunkContainer = new RingBufferChunkContainer(maxLoadRadius, maxVerticalLoadRadius);
+	}
+	else
+	{
+		m_chunkContainer = new HashMapChunkContainer();
+	}
+
+#ifdef __linux__
+	if (chunkIOBackend == ChunkIOBackendEnum::IO_URING)
+	{
+		IoUringChunkIO* ioUringChunkIO = new IoUringChunkIO(Constants::CHUNK_IO_QUEUE_DEPTH);
+		if (ioUringChunkIO->IsInitialized())
+		{
+			m_chunkIO = ioUringChunkIO;
+		}
+		else
+		{
+			std::cerr << "[World] io_uring is not available, using the thread pool for chunk I/O" << std::endl;
+			delete ioUringChunkIO;
+		}
+	}
+#endif
+
+	if (m_chunkIO == nullptr)
+	{
+		m_chunkIO = new ThreadPoolChunkIO(Constants::NUM_CHUNK_IO_THREADS);
+	}
+
+	size_t numThreads = numWorkerThreads;
+	if (m_chunkGenerationMode == ChunkGenerationModeEnum::TIME_SLICED)
+	{
+		numThreads = 0;
+	}
+	else if (numThreads == 0)
+	{
+		// hardware_concurrency() returns 0 if the number of cores is unknown
+		unsigned int numCores = std::thread::hardware_concurrency();
+		numThreads = (numCores > 1) ? (numCores - 1) : 1;
+	}
+
+	m_jobSystem = new JobSystem(numThreads);
 }
 
 /**
@@ -32,39 +161,116 @@ World::World()
  */
 World::~World()
 {
+	// The jobs use the generation parameters, so they are finished first. Cancelled jobs skip their remaining work.
+	for (std::unordered_map<uint64_t, Chunk*>::iterator it = m_generatingChunks.begin(); it != m_generatingChunks.end(); ++it)
+	{
+		it->second->SetState(ChunkStateEnum::UNLOADING);
+	}
+	m_generatingChunks.clear();
+
+	m_jobSystem->WaitForAll();
+	for (size_t i = 0; i < m_chunkGenerations.size(); ++i)
+	{
+		delete m_chunkGenerations[i]->chunk;
+		delete m_chunkGenerations[i];
+	}
+	m_chunkGenerations.clear();
+
+	for (size_t i = 0; i < m_queuedGenerations.size(); ++i)
+	{
+		delete m_queuedGenerations[i]->chunk;
+		delete m_queuedGenerations[i];
+	}
+	m_queuedGenerations.clear();
+
+	if (m_timeSlicedGeneration != nullptr)
+	{
+		delete m_timeSlicedGeneration->chunk;
+		delete m_timeSlicedGeneration;
+		m_timeSlicedGeneration = nullptr;
+	}
+
+	delete m_jobSystem;
+	m_jobSystem = nullptr;
+
+	SaveChunks();
+
 	for (size_t i = 0; i < m_chunks.size(); ++i)
 	{
 		delete m_chunks[i];
 	}
 	m_chunks.clear();
+
+	delete m_chunkContainer;
+	m_chunkContainer = nullptr;
+
+	// Requests still held by the backend refer to the region files
+	delete m_chunkIO;
+	m_chunkIO = nullptr;
+
+	for (std::unordered_map<uint64_t, RegionFile*>::iterator it = m_regionFiles.begin(); it != m_regionFiles.end(); ++it)
+	{
+		delete it->second;
+	}
+	m_regionFiles.clear();
 }
 
 /**
- * @brief Sets the parameters for the world generation
+ * @brief Sets the parameters for the world generation.
+ * Waits for the chunks that are partly generated, which keep the previous parameters.
  * @param[in] params Struct containing the parameters for the world generation
  */
 void World::SetWorldGenParams(const WorldGenParams &params)
 {
+	m_jobSystem->WaitForAll();
+
+	// The chunk being time-sliced is finished with the parameters it was started with
+	if (m_timeSlicedGeneration != nullptr)
+	{
+		bool isDone = false;
+		while (!isDone)
+		{
+			isDone = AdvanceChunkGeneration(m_timeSlicedGeneration);
+		}
+
+		IntegrateGeneratedChunk(m_timeSlicedGeneration);
+		m_timeSlicedGeneration = nullptr;
+	}
+
 	m_worldGenParams = params;
 }
 
+/**
+ * @brief Sets the directory where modified chunks are saved, creating it if needed.
+ * Should be called before any chunk is loaded.
+ * @param[in] saveDirectory Path to the save directory. Saving is disabled if this is empty.
+ */
+void World::SetSaveDirectory(const std::string& saveDirectory)
+{
+	m_saveDirectory = saveDirectory;
+	if (m_saveDirectory.empty())
+	{
+		return;
+	}
+
+	// Fails harmlessly if the directory already exists
+#ifdef _WIN32
+	_mkdir(m_saveDirectory.c_str());
+#else
+	mkdir(m_saveDirectory.c_str(), 0755);
+#endif
+}
+
 /**
  * @brief Get chunk at the provided location indices
  * @param[in] chunkIndexX Chunk x-index
+ * @param[in] chunkIndexY Chunk y-index
  * @param[in] chunkIndexZ Chunk z-index
  * @return Chunk at the provided location. Returns nullptr if the chunk has not been generated yet.
  */
-Chunk* World::GetChunkAt(const int& chunkIndexX, const int& chunkIndexZ)
+Chunk* World::GetChunkAt(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ)
 {
-	for (size_t i = 0; i < m_chunks.size(); ++i)
-	{
-		if ((m_chunks[i]->GetChunkIndexX() == chunkIndexX) && (m_chunks[i]->GetChunkIndexZ() == chunkIndexZ))
-		{
-			return m_chunks[i];
-		}
-	}
-
-	return nullptr;
+	return m_chunkContainer->Get(chunkIndexX, chunkIndexY, chunkIndexZ);
 }
 
 /**
@@ -75,26 +281,41 @@ Chunk* World::GetChunkAt(const int& chunkIndexX, const int& chunkIndexZ)
 Chunk* World::GetChunkAtWorldPosition(const glm::vec3& worldPosition)
 {
 	glm::ivec3 chunkIndex = WorldPositionToChunkIndex(worldPosition);
-	return GetChunkAt(chunkIndex.x, chunkIndex.z);
+	return GetChunkAt(chunkIndex.x, chunkIndex.y, chunkIndex.z);
 }
 
 /**
  * @brief Gets the block at the given world position
  * @param[in] worldPosition World position
- * @return Block at the given world position
+ * @return Handle to the block at the given world position. The handle is not valid if the position is not in a loaded chunk.
  */
-Block* World::GetBlockAtWorldPosition(const glm::vec3& worldPosition)
+BlockHandle World::GetBlockAtWorldPosition(const glm::vec3& worldPosition)
 {
 	glm::ivec3 chunkIndex = WorldPositionToChunkIndex(worldPosition);
-	Chunk* chunk = GetChunkAt(chunkIndex.x, chunkIndex.z);
+	Chunk* chunk = GetChunkAt(chunkIndex.x, chunkIndex.y, chunkIndex.z);
+	return GetBlockInChunkAtWorldPosition(chunk, worldPosition);
+}
+
+/**
+ * @brief Gets the block at the given world position within the specified chunk
+ * @param[in] chunk Chunk containing the world position. Can be nullptr.
+ * @param[in] worldPosition World position
+ * @return Handle to the block at the given world position. The handle is not valid if the position is not in the chunk.
+ */
+BlockHandle World::GetBlockInChunkAtWorldPosition(Chunk* chunk, const glm::vec3& worldPosition)
+{
+	if (chunk == nullptr)
+	{
+		return BlockHandle();
+	}
 
-	glm::vec3 worldPositionCopy = worldPosition / Constants::BLOCK_SIZE;
-	glm::ivec3 blockPosition(0);
-	blockPosition.x = (static_cast<int>(glm::floor(worldPositionCopy.x)) + (Constants::CHUNK_WIDTH * glm::abs(chunkIndex.x))) % Constants::CHUNK_WIDTH;
-	blockPosition.y = (static_cast<int>(glm::floor(worldPositionCopy.y)) + (Constants::CHUNK_HEIGHT * glm::abs(chunkIndex.y))) % Constants::CHUNK_HEIGHT;
-	blockPosition.z = (static_cast<int>(glm::floor(worldPositionCopy.z)) + (Constants::CHUNK_DEPTH * glm::abs(chunkIndex.z))) % Constants::CHUNK_DEPTH;
+	glm::ivec3 blockPosition = CoordinateUtils::WorldToBlockPosition(worldPosition);
+	if (CoordinateUtils::BlockToChunkIndex(blockPosition) != chunk->GetChunkIndices())
+	{
+		return BlockHandle();
+	}
 
-	return chunk->GetBlockAt(blockPosition.x, blockPosition.y, blockPosition.z);
+	return BlockHandle(chunk, CoordinateUtils::BlockToLocalPosition(blockPosition));
 }
 
 /**
@@ -104,203 +325,1723 @@ Block* World::GetBlockAtWorldPosition(const glm::vec3& worldPosition)
  */
 glm::ivec3 World::WorldPositionToChunkIndex(const glm::vec3& worldPosition)
 {
-	glm::ivec3 ret(0);
-	ret.x = static_cast<int>(glm::floor(worldPosition.x / Constants::BLOCK_SIZE / Constants::CHUNK_WIDTH));
-	ret.z = static_cast<int>(glm::floor(worldPosition.z / Constants::BLOCK_SIZE / Constants::CHUNK_DEPTH));
-	return ret;
+	return CoordinateUtils::WorldToChunkIndex(worldPosition);
 }
 
 /**
- * @brief Generate chunk at the provided location indices
+ * @brief Generate chunk at the provided location indices on the calling thread, applying any edits saved for it
  * @param[in] chunkIndexX Chunk x-index
+ * @param[in] chunkIndexY Chunk y-index
  * @param[in] chunkIndexZ Chunk z-index
  * @return Generated chunk
  */
-Chunk* World::GenerateChunkAt(const int& chunkIndexX, const int& chunkIndexZ)
+Chunk* World::GenerateChunkAt(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ)
 {
-	int32_t worldCenterX = m_worldGenParams.worldSize / 2;
-	int32_t worldCenterZ = m_worldGenParams.worldSize / 2;
+	const uint8_t* data = nullptr;
+	size_t size = 0;
+	if (GetSavedChunkData(chunkIndexX, chunkIndexY, chunkIndexZ, data, size) && (static_cast<ChunkPayloadTypeEnum>(data[0]) == ChunkPayloadTypeEnum::EDIT_JOURNAL))
+	{
+		return GenerateChunkAt(chunkIndexX, chunkIndexY, chunkIndexZ, data + 1, size - 1);
+	}
 
-	int32_t fallOff = 64;
-	int32_t outerRadius = m_worldGenParams.worldSize / 2;
-	int32_t innerRadius = std::max(outerRadius - fallOff, 0);
-	int32_t squareOuterRadius = outerRadius * outerRadius;
-	int32_t squareInnerRadius = innerRadius * innerRadius;
+	return GenerateChunkAt(chunkIndexX, chunkIndexY, chunkIndexZ, nullptr, 0);
+}
 
-	Chunk* chunk = GetChunkAt(chunkIndexX, chunkIndexZ);
+/**
+ * @brief Generate chunk at the provided location indices, applying the provided saved edits
+ * @param[in] chunkIndexX Chunk x-index
+ * @param[in] chunkIndexY Chunk y-index
+ * @param[in] chunkIndexZ Chunk z-index
+ * @param[in] savedEdits Serialized edit journal of the chunk. Can be nullptr if the chunk has no saved edits.
+ * @param[in] savedEditsSize Size of the edit journal in bytes
+ * @return Generated chunk
+ */
+Chunk* World::GenerateChunkAt(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ, const uint8_t* savedEdits, const size_t& savedEditsSize)
+{
+	Chunk* chunk = GetChunkAt(chunkIndexX, chunkIndexY, chunkIndexZ);
 	if (chunk == nullptr)
 	{
-		chunk = new Chunk(chunkIndexX, chunkIndexZ);
-		for (int x = 0; x < Constants::CHUNK_WIDTH; ++x)
-		{
-			for (int z = 0; z < Constants::CHUNK_DEPTH; ++z)
-			{
-				int32_t blockX = chunkIndexX * Constants::CHUNK_WIDTH + x;
-				int32_t blockZ = chunkIndexZ * Constants::CHUNK_DEPTH + z;
-				int32_t squareDistance = (blockX - worldCenterX) * (blockX - worldCenterX) + (blockZ - worldCenterZ) * (blockZ - worldCenterZ);
+		chunk = m_chunkPool.Acquire(chunkIndexX, chunkIndexY, chunkIndexZ);
+		chunk->SetState(ChunkStateEnum::GENERATING);
+		GenerateBlocks(chunk, chunk->GetCancellationToken(), savedEdits, savedEditsSize);
+		chunk->SetState(ChunkStateEnum::GENERATED);
 
-				float heightFactor = 1.0f;
-				if (squareDistance < squareInnerRadius)
-				{
-					heightFactor = 1.0f;
-				}
-				else if (squareInnerRadius <= squareDistance && squareDistance <= squareOuterRadius)
-				{
-					heightFactor = (squareDistance - squareInnerRadius) * 1.0f / (squareOuterRadius - squareInnerRadius);
-					heightFactor = 1.0f - heightFactor;
-				}
-				else
-				{
-					heightFactor = 0.0f;
-				}
+		chunk->SetState(ChunkStateEnum::MESHING);
+		chunk->GenerateMesh();
+		chunk = FinishChunkGeneration(chunk);
+	}
 
-				float height = NoiseUtils::GetOctaveNoise
-				(
-					m_noiseEngine, 
-					blockX * 1.0f,
-					blockZ * 1.0f,
-					m_worldGenParams.noiseNumOctaves,
-					m_worldGenParams.noiseScale,
-					m_worldGenParams.noisePersistence,
-					m_worldGenParams.noiseLacunarity
-				);
-				height = (height + 1.0f) / 2.0f;
-				height *= heightFactor;
-
-				height = height * m_worldGenParams.worldMaxHeight;
-
-				int ceilHeight = static_cast<int>(glm::ceil(height));
-				for (int y = 0; y < ceilHeight; ++y)
-				{
-					Block* block = new Block(chunk->GetChunkIndices(), glm::ivec3(x, y, z));
-					if (y < 5)
-					{
-						block->SetBlockType(BlockTypeEnum::STONE);
-					}
-					else if ((y > 8) && (y < 14))
-					{
-						block->SetBlockType(BlockTypeEnum::SAND);
-					}
-					else
-					{
-						block->SetBlockType(BlockTypeEnum::DIRT);
-					}
-
-					chunk->SetBlockAt(x, y, z, block);
-				}
+	return chunk;
+}
 
-				int waterHeight = 10;
-				for (int y = waterHeight; y >= 0; --y)
-				{
-					Block* block = chunk->GetBlockAt(x, y, z);
-					if (block == nullptr)
-					{
-						block = new Block(chunk->GetChunkIndices(), glm::ivec3(x, y, z));
-						block->SetBlockType(BlockTypeEnum::WATER);
-						chunk->SetBlockAt(x, y, z, block);
-					}
-				}
-			}
+/**
+ * @brief Queues the chunk at the provided location indices for generation.
+ * The chunk is added to the world once it was generated and its meshes have been uploaded.
+ * @param[in] chunkIndexX Chunk x-index
+ * @param[in] chunkIndexY Chunk y-index
+ * @param[in] chunkIndexZ Chunk z-index
+ * @param[in] savedEdits Serialized edit journal of the chunk. Can be nullptr if the chunk has no saved edits.
+ * @param[in] savedEditsSize Size of the edit journal in bytes
+ */
+void World::RequestChunkGeneration(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ, const uint8_t* savedEdits, const size_t& savedEditsSize)
+{
+	uint64_t key = CoordinateUtils::PackChunkIndex(chunkIndexX, chunkIndexY, chunkIndexZ);
+	if (m_generatingChunks.find(key) != m_generatingChunks.end())
+	{
+		return;
+	}
+
+	// The chunk stays in the requested state until its jobs are submitted
+	Chunk* chunk = m_chunkPool.Acquire(chunkIndexX, chunkIndexY, chunkIndexZ);
+	m_generatingChunks[key] = chunk;
+
+	// The saved edits are copied since the region file they point into can be remapped before the job runs
+	PendingChunkGeneration* generation = new PendingChunkGeneration();
+	generation->chunk = chunk;
+	generation->cancellationToken = chunk->GetCancellationToken();
+	if (savedEdits != nullptr)
+	{
+		generation->savedEdits.assign(savedEdits, savedEdits + savedEditsSize);
+	}
+	generation->isCancelled = false;
+	generation->uploadJob = nullptr;
+	generation->priority = 0.0f;
+	generation->numCompletedSteps = 0;
+
+	m_queuedGenerations.push_back(generation);
+	m_isGenerationQueueDirty = true;
+}
+
+/**
+ * @brief If the view or the queue changed, releases the queued chunks that were cancelled and sorts the others by priority
+ */
+void World::SortQueuedGenerations()
+{
+	if (m_queuedGenerations.empty() || !m_isGenerationQueueDirty)
+	{
+		return;
+	}
+
+	size_t numQueued = 0;
+	for (size_t i = 0; i < m_queuedGenerations.size(); ++i)
+	{
+		PendingChunkGeneration* generation = m_queuedGenerations[i];
+		if (generation->cancellationToken.IsCancelled())
+		{
+			ReleaseChunk(generation->chunk);
+			delete generation;
+			continue;
 		}
-		chunk->GenerateMesh();
-		m_chunks.push_back(chunk);
+
+		Chunk* chunk = generation->chunk;
+		generation->priority = GetGenerationPriority(glm::ivec3(chunk->GetChunkIndexX(), chunk->GetChunkIndexY(), chunk->GetChunkIndexZ()));
+		m_queuedGenerations[numQueued] = generation;
+		++numQueued;
 	}
+	m_queuedGenerations.resize(numQueued);
 
-	return chunk;
+	// Ties are broken by the chunk indices, so the chunks are submitted in the same order on every run
+	std::sort(m_queuedGenerations.begin(), m_queuedGenerations.end(), [](const PendingChunkGeneration* a, const PendingChunkGeneration* b)
+	{
+		if (a->priority != b->priority)
+		{
+			return a->priority > b->priority;
+		}
+
+		const Chunk* chunkA = a->chunk;
+		const Chunk* chunkB = b->chunk;
+		if (chunkA->GetChunkIndexX() != chunkB->GetChunkIndexX())
+		{
+			return chunkA->GetChunkIndexX() > chunkB->GetChunkIndexX();
+		}
+		if (chunkA->GetChunkIndexY() != chunkB->GetChunkIndexY())
+		{
+			return chunkA->GetChunkIndexY() > chunkB->GetChunkIndexY();
+		}
+		return chunkA->GetChunkIndexZ() > chunkB->GetChunkIndexZ();
+	});
+	m_isGenerationQueueDirty = false;
 }
 
 /**
- * @brief Load chunks around the area defined by the center chunk index
- * and the radius in chunks
- * @param[in] centerChunkIndex Center chunk index
- * @param[in] radius Radius in chunks
+ * @brief Takes the queued chunk with the highest priority, releasing the cancelled chunks in front of it
+ * @return Queued chunk. Returns nullptr if the queue is empty.
  */
-void World::LoadChunksWithinArea(const glm::ivec3& centerChunkIndex, const int& radius)
+World::PendingChunkGeneration* World::TakeQueuedGeneration()
 {
-	for (int x = centerChunkIndex.x - radius; x <= centerChunkIndex.x + radius; ++x)
+	while (!m_queuedGenerations.empty())
 	{
-		for (int z = centerChunkIndex.z - radius; z <= centerChunkIndex.z + radius; ++z)
+		PendingChunkGeneration* generation = m_queuedGenerations.back();
+		m_queuedGenerations.pop_back();
+
+		if (!generation->cancellationToken.IsCancelled())
 		{
-			if (GetChunkAt(x, z) == nullptr)
-			{
-				GenerateChunkAt(x, z);
-			}
+			return generation;
 		}
+
+		ReleaseChunk(generation->chunk);
+		delete generation;
 	}
+
+	return nullptr;
 }
 
 /**
- * @brief Unload chunks outside the area defined by the center chunk index
- * and the radius in chunks
- * @param[in] centerChunkIndex Center chunk index
- * @param radius Radius in chunks
+ * @brief Submits the queued chunks with the highest priority until the job system has enough chunks to work on.
+ * Queued chunks that were cancelled are released.
  */
-void World::UnloadChunksOutsideArea(const glm::ivec3& centerChunkIndex, const int& radius)
+void World::SubmitQueuedGenerations()
 {
-	for (size_t i = 0; i < m_chunks.size(); ++i)
+	// Time-sliced chunks are taken from the queue by GenerateChunksForTime() instead
+	if (m_chunkGenerationMode != ChunkGenerationModeEnum::JOB_SYSTEM)
 	{
-		int chunkIndexX = m_chunks[i]->GetChunkIndexX();
-		int chunkIndexZ = m_chunks[i]->GetChunkIndexZ();
+		return;
+	}
 
-		int minX = centerChunkIndex.x - radius;
-		int maxX = centerChunkIndex.x + radius;
+	SortQueuedGenerations();
 
-		int minZ = centerChunkIndex.z - radius;
-		int maxZ = centerChunkIndex.z + radius;
+	// Only about a frame of work is handed over, so chunks that become visible later can still overtake the rest
+	size_t maxSubmitted = m_jobSystem->GetWorkerCount() * Constants::MAX_CHUNK_GENERATIONS_PER_WORKER;
+	while (m_chunkGenerations.size() < maxSubmitted)
+	{
+		PendingChunkGeneration* generation = TakeQueuedGeneration();
+		if (generation == nullptr)
+		{
+			break;
+		}
+
+		SubmitChunkGeneration(generation);
+	}
+}
+
+/**
+ * @brief Submits the jobs that generate the chunk, mesh it and upload the meshes
+ * @param[in] generation Queued chunk
+ */
+void World::SubmitChunkGeneration(PendingChunkGeneration* generation)
+{
+	generation->chunk->SetState(ChunkStateEnum::GENERATING);
 
-		if ((chunkIndexX < minX) || (chunkIndexX > maxX) || (chunkIndexZ < minZ) || (chunkIndexZ > maxZ))
+	std::shared_ptr<Job> generateJob = std::make_shared<Job>([this, generation]()
+	{
+		const uint8_t* edits = generation->savedEdits.empty() ? nullptr : generation->savedEdits.data();
+		generation->isCancelled = generation->cancellationToken.IsCancelled()
+			|| !GenerateBlocks(generation->chunk, generation->cancellationToken, edits, generation->savedEdits.size());
+		if (!generation->isCancelled)
 		{
-			delete m_chunks[i];
+			generation->chunk->AdvanceState(ChunkStateEnum::GENERATING, ChunkStateEnum::GENERATED);
+		}
+	});
 
-			m_chunks[i] = m_chunks.back();
-			m_chunks.pop_back();
-			--i;
+	// Meshes only depend on the blocks of their own chunk, so meshing does not wait for the neighbors
+	std::shared_ptr<Job> meshJob = std::make_shared<Job>([generation]()
+	{
+		generation->isCancelled = generation->isCancelled || generation->cancellationToken.IsCancelled();
+		if (!generation->isCancelled)
+		{
+			generation->chunk->AdvanceState(ChunkStateEnum::GENERATED, ChunkStateEnum::MESHING);
+			generation->chunk->BuildMeshes();
 		}
-	}
+	});
+	meshJob->DependOn(generateJob);
+
+	std::shared_ptr<Job> uploadJob = std::make_shared<Job>([generation]()
+	{
+		generation->isCancelled = generation->isCancelled || generation->cancellationToken.IsCancelled();
+		if (!generation->isCancelled)
+		{
+			generation->chunk->UploadMeshes();
+		}
+	}, JobAffinityEnum::MAIN_THREAD);
+	uploadJob->DependOn(meshJob);
+
+	// The jobs refer to the pending generation, which is only deleted once the upload job has completed
+	generation->uploadJob = uploadJob;
+	m_chunkGenerations.push_back(generation);
+
+	m_jobSystem->Submit(generateJob);
+	m_jobSystem->Submit(meshJob);
+	m_jobSystem->Submit(uploadJob);
 }
 
 /**
- * @brief Draws the terrain meshes
+ * @brief Gets the priority of generating the chunk at the provided location indices,
+ * based on its distance to the camera and its angle to the view direction
+ * @param[in] chunkIndex Chunk index
+ * @return Priority value. Chunks with lower values are generated first.
  */
-void World::DrawTerrainMeshes()
+float World::GetGenerationPriority(const glm::ivec3& chunkIndex) const
 {
-	for (size_t i = 0; i < m_chunks.size(); ++i)
+	glm::vec3 chunkSize = glm::vec3(Constants::CHUNK_WIDTH, Constants::CHUNK_HEIGHT, Constants::CHUNK_DEPTH) * Constants::BLOCK_SIZE;
+	glm::vec3 toChunk = (glm::vec3(chunkIndex) + 0.5f) * chunkSize - m_viewPosition;
+	float distance = glm::length(toChunk);
+
+	// The chunks around the camera are needed whichever way it turns
+	if (distance < chunkSize.x)
 	{
-		Mesh *terrainMesh = m_chunks[i]->GetTerrainMesh();
-		terrainMesh->Draw();
+		return distance;
 	}
+
+	// Chunks behind the camera count as twice as far away as chunks straight ahead
+	float cosAngle = glm::dot(toChunk / distance, m_viewDirection);
+	return distance * (1.5f - 0.5f * cosAngle);
 }
 
 /**
- * @brief Draws the water meshes
+ * @brief Fills the chunk with the generated terrain, then applies the saved edits and compacts its sections.
+ * Only touches the chunk and reads the generation parameters, so it can run on the job system threads.
+ * @param[in] chunk Chunk that was just acquired from the chunk pool
+ * @param[in] cancellationToken Token checked between columns of blocks
+ * @param[in] savedEdits Serialized edit journal of the chunk. Can be nullptr if the chunk has no saved edits.
+ * @param[in] savedEditsSize Size of the edit journal in bytes
+ * @return True if the block data was generated, false if the generation was cancelled
  */
-void World::DrawWaterMeshes()
+bool World::GenerateBlocks(Chunk* chunk, const CancellationToken& cancellationToken, const uint8_t* savedEdits, const size_t& savedEditsSize)
 {
-	for (size_t i = 0; i < m_chunks.size(); ++i)
+	for (int x = 0; x < Constants::CHUNK_WIDTH; ++x)
 	{
-		Mesh *waterMesh = m_chunks[i]->GetWaterMesh();
-		waterMesh->Draw();
+		if (cancellationToken.IsCancelled())
+		{
+			return false;
+		}
+
+		GenerateTerrainSlice(chunk, x);
 	}
+
+	FinishGeneratedBlocks(chunk, savedEdits, savedEditsSize);
+	return true;
 }
 
 /**
- * @brief Casts a ray and gets the first non-air block hit
- * @param ray Ray
- * @param maxDistance Maximum distance
- * @return First non-air block hit by the ray cast. If no blocks are hit, returns nullptr.
+ * @brief Fills one slice of columns of the chunk with the generated terrain
+ * @param[in] chunk Chunk being generated
+ * @param[in] x X-coordinate of the slice within the chunk
  */
-Block* World::Raycast(const Ray& ray, float maxDistance)
+void World::GenerateTerrainSlice(Chunk* chunk, const int& x)
 {
-	float step = Constants::BLOCK_SIZE;
-	for (float distance = 0.0f; distance <= maxDistance; distance += step)
+	int chunkIndexX = chunk->GetChunkIndexX();
+	int chunkIndexY = chunk->GetChunkIndexY();
+	int chunkIndexZ = chunk->GetChunkIndexZ();
+
+	int32_t worldCenterX = m_worldGenParams.worldSize / 2;
+	int32_t worldCenterZ = m_worldGenParams.worldSize / 2;
+
+	int32_t fallOff = 64;
+	int32_t outerRadius = m_worldGenParams.worldSize / 2;
+	int32_t innerRadius = std::max(outerRadius - fallOff, 0);
+	int32_t squareOuterRadius = outerRadius * outerRadius;
+	int32_t squareInnerRadius = innerRadius * innerRadius;
+
+	int32_t baseY = chunkIndexY * Constants::CHUNK_HEIGHT;
+	int32_t waterHeight = 10;
+
+	// Chunks outside the world height, or above both the tallest terrain and the water, stay empty
+	if ((chunkIndexY < 0) || (chunkIndexY >= Constants::WORLD_HEIGHT_IN_CHUNKS)
+		|| ((baseY >= static_cast<int32_t>(m_worldGenParams.worldMaxHeight)) && (baseY > waterHeight)))
 	{
-		glm::vec3 position = ray.origin + ray.direction * distance;
-		Block* block = GetBlockAtWorldPosition(position);
-		if (block != nullptr)
+		return;
+	}
+
+	// The noise of the whole slice is evaluated in one batch
+	int32_t blockX = chunkIndexX * Constants::CHUNK_WIDTH + x;
+	float noiseValues[Constants::CHUNK_DEPTH];
+	NoiseUtils::GetOctaveNoiseGrid
+	(
+		Constants::TERRAIN_NOISE_SEED,
+		Constants::NOISE_FREQUENCY,
+		blockX * 1.0f,
+		chunkIndexZ * Constants::CHUNK_DEPTH * 1.0f,
+		1,
+		Constants::CHUNK_DEPTH,
+		m_worldGenParams.noiseNumOctaves,
+		m_worldGenParams.noiseScale,
+		m_worldGenParams.noisePersistence,
+		m_worldGenParams.noiseLacunarity,
+		noiseValues
+	);
+
+	for (int z = 0; z < Constants::CHUNK_DEPTH; ++z)
+	{
+		int32_t blockZ = chunkIndexZ * Constants::CHUNK_DEPTH + z;
+		int32_t squareDistance = (blockX - worldCenterX) * (blockX - worldCenterX) + (blockZ - worldCenterZ) * (blockZ - worldCenterZ);
+
+		float heightFactor = 1.0f;
+		if (squareDistance < squareInnerRadius)
 		{
-			return block;
+			heightFactor = 1.0f;
+		}
+		else if (squareInnerRadius <= squareDistance && squareDistance <= squareOuterRadius)
+		{
+			heightFactor = (squareDistance - squareInnerRadius) * 1.0f / (squareOuterRadius - squareInnerRadius);
+			heightFactor = 1.0f - heightFactor;
+		}
+		else
+		{
+			heightFactor = 0.0f;
+		}
+
+		float height = (noiseValues[z] + 1.0f) / 2.0f;
+		height *= heightFactor;
+
+		height = height * m_worldGenParams.worldMaxHeight;
+
+		int ceilHeight = static_cast<int>(glm::ceil(height));
+		for (int y = 0; y < Constants::CHUNK_HEIGHT; ++y)
+		{
+			int32_t blockY = baseY + y;
+			if (blockY < ceilHeight)
+			{
+				if (blockY < 5)
+				{
+					chunk->SetBlockAt(x, y, z, BlockTypeEnum::STONE);
+				}
+				else if ((blockY > 8) && (blockY < 14))
+				{
+					chunk->SetBlockAt(x, y, z, BlockTypeEnum::SAND);
+				}
+				else
+				{
+					chunk->SetBlockAt(x, y, z, BlockTypeEnum::DIRT);
+				}
+			}
+			else if (blockY <= waterHeight)
+			{
+				chunk->SetBlockAt(x, y, z, BlockTypeEnum::WATER);
+			}
 		}
 	}
+}
 
-	return nullptr;
+/**
+ * @brief Applies the saved edits on top of the generated terrain and compacts the sections of the chunk
+ * @param[in] chunk Chunk whose terrain was generated
+ * @param[in] savedEdits Serialized edit journal of the chunk. Can be nullptr if the chunk has no saved edits.
+ * @param[in] savedEditsSize Size of the edit journal in bytes
+ */
+void World::FinishGeneratedBlocks(Chunk* chunk, const uint8_t* savedEdits, const size_t& savedEditsSize) const
+{
+	// Only changes made from this point on need to be saved
+	chunk->StartRecordingEdits();
+	if (savedEdits != nullptr)
+	{
+		ReplaySavedEdits(chunk, savedEdits, savedEditsSize);
+	}
+
+	chunk->CompactSections();
+}
+
+/**
+ * @brief Does the next step of the time-sliced generation of the chunk:
+ * a slice of terrain, the saved edits, the meshes of a section, or the upload of the meshes
+ * @param[in] generation Chunk being generated
+ * @return True if the meshes were uploaded and the chunk is ready to be added to the world
+ */
+bool World::AdvanceChunkGeneration(PendingChunkGeneration* generation)
+{
+	if (generation->cancellationToken.IsCancelled())
+	{
+		generation->isCancelled = true;
+		return true;
+	}
+
+	// One step per slice of terrain, one for the saved edits, one per section mesh, then the upload
+	Chunk* chunk = generation->chunk;
+	int step = generation->numCompletedSteps;
+	++generation->numCompletedSteps;
+	if (step < Constants::CHUNK_WIDTH)
+	{
+		GenerateTerrainSlice(chunk, step);
+		return false;
+	}
+
+	step -= Constants::CHUNK_WIDTH;
+	if (step == 0)
+	{
+		const uint8_t* edits = generation->savedEdits.empty() ? nullptr : generation->savedEdits.data();
+		FinishGeneratedBlocks(chunk, edits, generation->savedEdits.size());
+		chunk->SetState(ChunkStateEnum::GENERATED);
+		return false;
+	}
+
+	step -= 1;
+	if (step < Constants::CHUNK_SECTION_COUNT)
+	{
+		if (step == 0)
+		{
+			chunk->SetState(ChunkStateEnum::MESHING);
+			chunk->ClearMeshData();
+		}
+
+		chunk->BuildSectionMeshes(step);
+		return false;
+	}
+
+	chunk->UploadMeshes();
+	return true;
+}
+
+/**
+ * @brief Shares the sections of a chunk whose meshes were uploaded and adds it to the world
+ * @param[in] chunk Generated chunk with uploaded meshes
+ * @return Added chunk. Returns nullptr if there is no room for it.
+ */
+Chunk* World::FinishChunkGeneration(Chunk* chunk)
+{
+	chunk->ShareSections(m_sharedSections);
+	chunk->SetState(ChunkStateEnum::UPLOADED);
+	chunk->MarkSaved();
+
+	if (!AddChunk(chunk))
+	{
+		std::cerr << "[World] No room in the chunk container for chunk " << chunk->GetChunkIndexX() << ", " << chunk->GetChunkIndexY() << ", " << chunk->GetChunkIndexZ() << std::endl;
+		ReleaseChunk(chunk);
+		chunk = nullptr;
+	}
+
+	return chunk;
+}
+
+/**
+ * @brief Adds the chunks whose jobs completed to the world, in the order they were submitted.
+ * Chunks that were cancelled are released.
+ */
+void World::IntegrateGeneratedChunks()
+{
+	// Later chunks wait for earlier ones, so the chunks are added in the same order for any number of threads
+	while (!m_chunkGenerations.empty() && m_chunkGenerations.front()->uploadJob->IsCompleted())
+	{
+		PendingChunkGeneration* generation = m_chunkGenerations.front();
+		m_chunkGenerations.pop_front();
+		IntegrateGeneratedChunk(generation);
+	}
+}
+
+/**
+ * @brief Adds the chunk whose meshes were uploaded to the world, or releases it if it was cancelled, then deletes the pending generation
+ * @param[in] generation Generated chunk
+ */
+void World::IntegrateGeneratedChunk(PendingChunkGeneration* generation)
+{
+	Chunk* chunk = generation->chunk;
+	uint64_t key = CoordinateUtils::PackChunkIndex(chunk->GetChunkIndexX(), chunk->GetChunkIndexY(), chunk->GetChunkIndexZ());
+
+	// Cancelled chunks were already removed from the generating chunks, and may have been requested again since
+	std::unordered_map<uint64_t, Chunk*>::iterator it = m_generatingChunks.find(key);
+	if ((it == m_generatingChunks.end()) || (it->second != chunk) || generation->isCancelled)
+	{
+		ReleaseChunk(chunk);
+	}
+	else
+	{
+		m_generatingChunks.erase(it);
+		if (GetChunkAt(chunk->GetChunkIndexX(), chunk->GetChunkIndexY(), chunk->GetChunkIndexZ()) != nullptr)
+		{
+			ReleaseChunk(chunk);
+		}
+		else
+		{
+			FinishChunkGeneration(chunk);
+		}
+	}
+
+	delete generation;
+}
+
+/**
+ * @brief Loads the chunk at the provided location indices from its saved block data, reading it on the calling thread
+ * @param[in] chunkIndexX Chunk x-index
+ * @param[in] chunkIndexY Chunk y-index
+ * @param[in] chunkIndexZ Chunk z-index
+ * @return Loaded chunk. Returns nullptr if the chunk was never saved.
+ */
+Chunk* World::LoadChunkAt(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ)
+{
+	// Chunks saved as edit journals are restored by GenerateChunkAt() instead
+	const uint8_t* data = nullptr;
+	size_t size = 0;
+	if (!GetSavedChunkData(chunkIndexX, chunkIndexY, chunkIndexZ, data, size)
+		|| (static_cast<ChunkPayloadTypeEnum>(data[0]) != ChunkPayloadTypeEnum::BLOCK_DATA))
+	{
+		return nullptr;
+	}
+
+	return DeserializeChunkAt(chunkIndexX, chunkIndexY, chunkIndexZ, data + 1, size - 1);
+}
+
+/**
+ * @brief Saves the chunk to its region file if it has unsaved changes.
+ * Chunks are saved as a journal of their edits when that is smaller than their complete block data.
+ * The data is written in the background once the chunk I/O batch is submitted.
+ * @param[in] chunk Chunk to save
+ */
+void World::SaveChunk(Chunk* chunk)
+{
+	if (!chunk->HasUnsavedChanges())
+	{
+		return;
+	}
+
+	int localX = 0;
+	int localY = 0;
+	int localZ = 0;
+	RegionFile* regionFile = GetRegionFile(chunk->GetChunkIndexX(), chunk->GetChunkIndexY(), chunk->GetChunkIndexZ(), localX, localY, localZ);
+	if (regionFile == nullptr)
+	{
+		return;
+	}
+
+	// Save only the changes made to the generated terrain when possible
+	std::shared_ptr<std::vector<uint8_t>> buffer = std::make_shared<std::vector<uint8_t>>();
+	if (chunk->IsRecordingEdits())
+	{
+		chunk->CompactEditJournal();
+		buffer->push_back(static_cast<uint8_t>(ChunkPayloadTypeEnum::EDIT_JOURNAL));
+		chunk->GetEditJournal().Serialize(*buffer);
+	}
+
+	// Heavily edited chunks take up less space as complete block data
+	if (buffer->empty() || (buffer->size() > Constants::REGION_PAGE_SIZE))
+	{
+		std::vector<uint8_t> blockData;
+		blockData.push_back(static_cast<uint8_t>(ChunkPayloadTypeEnum::BLOCK_DATA));
+		chunk->Serialize(blockData);
+		if (buffer->empty() || (blockData.size() < buffer->size()))
+		{
+			buffer->swap(blockData);
+		}
+	}
+
+	// Data that fits is rewritten in place, so an earlier save of the chunk has to land first or it could overwrite this one
+	int chunkIndexX = chunk->GetChunkIndexX();
+	int chunkIndexY = chunk->GetChunkIndexY();
+	int chunkIndexZ = chunk->GetChunkIndexZ();
+	PendingChunkWrite& pendingWrite = m_pendingWrites[CoordinateUtils::PackChunkIndex(chunkIndexX, chunkIndexY, chunkIndexZ)];
+	if (pendingWrite.numInFlight > 0)
+	{
+		m_chunkIO->WaitForAll();
+	}
+
+	uint64_t offset = 0;
+	if (!regionFile->ReserveChunk(localX, localY, localZ, buffer->size(), offset))
+	{
+		if (pendingWrite.numInFlight == 0)
+		{
+			m_pendingWrites.erase(CoordinateUtils::PackChunkIndex(chunkIndexX, chunkIndexY, chunkIndexZ));
+		}
+		std::cerr << "[World] Failed to save chunk " << chunkIndexX << ", " << chunkIndexY << ", " << chunkIndexZ << std::endl;
+		return;
+	}
+
+	pendingWrite.data = buffer;
+	pendingWrite.chunkIndex = glm::ivec3(chunkIndexX, chunkIndexY, chunkIndexZ);
+	pendingWrite.regionFile = regionFile;
+	pendingWrite.offset = offset;
+	pendingWrite.numFailedWrites = 0;
+	WriteChunkData(pendingWrite);
+
+	// Marked as unsaved again if the write keeps failing while the chunk is still around
+	chunk->MarkSaved();
+}
+
+/**
+ * @brief Saves every loaded chunk that has unsaved changes, writes the saves that failed earlier again,
+ * and waits until every pending write has completed
+ */
+void World::SaveChunks()
+{
+	for (std::unordered_map<uint64_t, PendingChunkWrite>::iterator it = m_pendingWrites.begin(); it != m_pendingWrites.end(); ++it)
+	{
+		PendingChunkWrite& pendingWrite = it->second;
+		if ((pendingWrite.numInFlight == 0) && (pendingWrite.numFailedWrites > 0))
+		{
+			pendingWrite.numFailedWrites = 0;
+			WriteChunkData(pendingWrite);
+		}
+	}
+
+	for (size_t i = 0; i < m_chunks.size(); ++i)
+	{
+		SaveChunk(m_chunks[i]);
+	}
+
+	const std::list<Chunk*>& cachedChunks = m_chunkCache.GetChunks();
+	for (std::list<Chunk*>::const_iterator it = cachedChunks.begin(); it != cachedChunks.end(); ++it)
+	{
+		SaveChunk(*it);
+	}
+
+	m_chunkIO->WaitForAll();
+
+	for (std::unordered_map<uint64_t, RegionFile*>::iterator it = m_regionFiles.begin(); it != m_regionFiles.end(); ++it)
+	{
+		if (it->second != nullptr)
+		{
+			it->second->Flush();
+		}
+	}
+}
+
+/**
+ * @brief Reads the chunks whose reads failed again, loads the chunks whose saved data finished reading, runs the main thread jobs, adds the chunks whose jobs
+ * completed to the world, and submits the chunk I/O requested since the last call. Should be called once per frame.
+ */
+void World::PollChunkIO()
+{
+	RetryFailedLoads();
+	m_chunkIO->PollCompletions();
+	m_jobSystem->RunMainThreadJobs();
+	IntegrateGeneratedChunks();
+	SubmitQueuedGenerations();
+	m_chunkIO->Submit();
+}
+
+/**
+ * @brief Generates and meshes the queued chunks on the calling thread, a slice of blocks or a section at a time,
+ * until the time budget runs out. The chunk that is not done yet is resumed on the next call.
+ * Does nothing unless the world was created with ChunkGenerationModeEnum::TIME_SLICED. Should be called once per frame.
+ * @param[in] timeBudget Time budget in milliseconds
+ */
+void World::GenerateChunksForTime(const float& timeBudget)
+{
+	if (m_chunkGenerationMode != ChunkGenerationModeEnum::TIME_SLICED)
+	{
+		return;
+	}
+
+	SortQueuedGenerations();
+
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	std::chrono::duration<float, std::milli> elapsedTime(0.0f);
+	while (elapsedTime.count() < timeBudget)
+	{
+		if (m_timeSlicedGeneration == nullptr)
+		{
+			m_timeSlicedGeneration = TakeQueuedGeneration();
+			if (m_timeSlicedGeneration == nullptr)
+			{
+				break;
+			}
+
+			m_timeSlicedGeneration->chunk->SetState(ChunkStateEnum::GENERATING);
+		}
+
+		if (AdvanceChunkGeneration(m_timeSlicedGeneration))
+		{
+			IntegrateGeneratedChunk(m_timeSlicedGeneration);
+			m_timeSlicedGeneration = nullptr;
+		}
+
+		elapsedTime = std::chrono::steady_clock::now() - startTime;
+	}
+}
+
+/**
+ * @brief Sets the camera position and direction used to decide which requested chunks are generated first.
+ * Chunks close to the camera and in front of it are generated before the others.
+ * @param[in] position Camera position
+ * @param[in] direction Direction the camera is looking at
+ */
+void World::SetViewpoint(const glm::vec3& position, const glm::vec3& direction)
+{
+	if ((position == m_viewPosition) && (direction == m_viewDirection))
+	{
+		return;
+	}
+
+	m_viewPosition = position;
+	m_viewDirection = direction;
+	m_isGenerationQueueDirty = true;
+}
+
+/**
+ * @brief Load chunks around the area defined by the center chunk index
+ * and the radius in chunks. Chunks outside the world height are never loaded.
+ * @param[in] centerChunkIndex Center chunk index
+ * @param[in] radius Horizontal radius in chunks
+ * @param[in] verticalRadius Vertical radius in chunks
+ */
+void World::LoadChunksWithinArea(const glm::ivec3& centerChunkIndex, const int& radius, const int& verticalRadius)
+{
+	m_loadCenter = centerChunkIndex;
+	m_loadRadius = radius;
+	m_loadVerticalRadius = verticalRadius;
+
+	int minY = glm::max(centerChunkIndex.y - verticalRadius, 0);
+	int maxY = glm::min(centerChunkIndex.y + verticalRadius, Constants::WORLD_HEIGHT_IN_CHUNKS - 1);
+	for (int x = centerChunkIndex.x - radius; x <= centerChunkIndex.x + radius; ++x)
+	{
+		for (int z = centerChunkIndex.z - radius; z <= centerChunkIndex.z + radius; ++z)
+		{
+			for (int y = minY; y <= maxY; ++y)
+			{
+				// Saved chunks are added once their data has been read, and new chunks once they have been generated
+				if ((GetChunkAt(x, y, z) == nullptr) && (m_generatingChunks.find(CoordinateUtils::PackChunkIndex(x, y, z)) == m_generatingChunks.end())
+					&& (RestoreCachedChunkAt(x, y, z) == nullptr) && !RequestChunkLoad(x, y, z))
+				{
+					RequestChunkGeneration(x, y, z, nullptr, 0);
+				}
+			}
+		}
+	}
+
+	SubmitQueuedGenerations();
+	m_chunkIO->Submit();
+}
+
+/**
+ * @brief Unload chunks outside the area defined by the center chunk index
+ * and the radius in chunks. Unloaded chunks are kept in the chunk cache while it is within its budget.
+ * @param[in] centerChunkIndex Center chunk index
+ * @param radius Horizontal radius in chunks
+ * @param verticalRadius Vertical radius in chunks
+ */
+void World::UnloadChunksOutsideArea(const glm::ivec3& centerChunkIndex, const int& radius, const int& verticalRadius)
+{
+	for (size_t i = 0; i < m_chunks.size(); ++i)
+	{
+		int chunkIndexX = m_chunks[i]->GetChunkIndexX();
+		int chunkIndexY = m_chunks[i]->GetChunkIndexY();
+		int chunkIndexZ = m_chunks[i]->GetChunkIndexZ();
+
+		int minX = centerChunkIndex.x - radius;
+		int maxX = centerChunkIndex.x + radius;
+
+		int minY = centerChunkIndex.y - verticalRadius;
+		int maxY = centerChunkIndex.y + verticalRadius;
+
+		int minZ = centerChunkIndex.z - radius;
+		int maxZ = centerChunkIndex.z + radius;
+
+		if ((chunkIndexX < minX) || (chunkIndexX > maxX) || (chunkIndexY < minY) || (chunkIndexY > maxY) || (chunkIndexZ < minZ) || (chunkIndexZ > maxZ))
+		{
+			// Work still pending for the chunk gets cancelled
+			RemoveChunkFromIndex(m_chunks[i]);
+			m_chunks[i]->SetState(ChunkStateEnum::UNLOADING);
+			m_chunkCache.Insert(m_chunks[i]);
+
+			m_chunks[i] = m_chunks.back();
+			m_chunks.pop_back();
+			--i;
+		}
+	}
+
+	// Chunks still being generated are released once their job notices the cancellation, and queued chunks before they are submitted
+	for (std::unordered_map<uint64_t, Chunk*>::iterator it = m_generatingChunks.begin(); it != m_generatingChunks.end();)
+	{
+		Chunk* chunk = it->second;
+		if ((glm::abs(chunk->GetChunkIndexX() - centerChunkIndex.x) > radius) || (glm::abs(chunk->GetChunkIndexY() - centerChunkIndex.y) > verticalRadius)
+			|| (glm::abs(chunk->GetChunkIndexZ() - centerChunkIndex.z) > radius))
+		{
+			chunk->SetState(ChunkStateEnum::UNLOADING);
+			it = m_generatingChunks.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+
+	EvictCachedChunks();
+}
+
+/**
+ * @brief Draws the terrain meshes
+ */
+void World::DrawTerrainMeshes()
+{
+	for (size_t i = 0; i < m_chunks.size(); ++i)
+	{
+		Mesh *terrainMesh = m_chunks[i]->GetTerrainMesh();
+		terrainMesh->Draw();
+	}
+}
+
+/**
+ * @brief Draws the water meshes
+ */
+void World::DrawWaterMeshes()
+{
+	for (size_t i = 0; i < m_chunks.size(); ++i)
+	{
+		Mesh *waterMesh = m_chunks[i]->GetWaterMesh();
+		waterMesh->Draw();
+	}
+}
+
+/**
+ * @brief Casts a ray and gets the first non-air block hit
+ * @param ray Ray
+ * @param maxDistance Maximum distance
+ * @return Handle to the first non-air block hit by the ray cast. If no blocks are hit, the handle is not valid.
+ */
+BlockHandle World::Raycast(const Ray& ray, float maxDistance)
+{
+	Chunk* chunk = nullptr;
+
+	float step = Constants::BLOCK_SIZE;
+	for (float distance = 0.0f; distance <= maxDistance; distance += step)
+	{
+		glm::vec3 position = ray.origin + ray.direction * distance;
+
+		// Consecutive steps are usually in the same chunk, or in an adjacent one
+		glm::ivec3 blockPosition = CoordinateUtils::WorldToBlockPosition(position);
+		glm::ivec3 chunkIndex = CoordinateUtils::BlockToChunkIndex(blockPosition);
+		if ((chunk == nullptr) || (chunk->GetChunkIndices() != chunkIndex))
+		{
+			chunk = GetChunkNear(chunk, chunkIndex.x, chunkIndex.y, chunkIndex.z);
+		}
+
+		if (chunk == nullptr)
+		{
+			continue;
+		}
+
+		BlockHandle block(chunk, CoordinateUtils::BlockToLocalPosition(blockPosition));
+
+		if (block.y >= chunk->GetMaxHeight())
+		{
+			// Everything above the tallest column is air, skip to the last sample that is still inside it
+			float exitDistance = GetChunkSliceExitDistance(ray, chunk, chunk->GetMaxHeight(), Constants::CHUNK_HEIGHT);
+			distance = glm::max(distance, glm::floor(exitDistance / step) * step);
+			continue;
+		}
+
+		int sectionIndex = block.y / Constants::SECTION_HEIGHT;
+		if (chunk->GetSection(sectionIndex) == nullptr)
+		{
+			// Skip to the last sample that is still inside this empty section
+			float exitDistance = GetChunkSliceExitDistance(ray, chunk, sectionIndex * Constants::SECTION_HEIGHT, (sectionIndex + 1) * Constants::SECTION_HEIGHT);
+			distance = glm::max(distance, glm::floor(exitDistance / step) * step);
+			continue;
+		}
+
+		if (chunk->IsSolidAt(block.x, block.y, block.z) || chunk->IsLiquidAt(block.x, block.y, block.z))
+		{
+			return block;
+		}
+	}
+
+	return BlockHandle();
+}
+
+/**
+ * @brief Gets the number of bytes used by the block data of all loaded chunks
+ * @return Block data memory usage in bytes
+ */
+size_t World::GetBlockMemoryUsage() const
+{
+	size_t ret = 0;
+	for (size_t i = 0; i < m_chunks.size(); ++i)
+	{
+		ret += m_chunks[i]->GetBlockMemoryUsage();
+	}
+	return ret;
+}
+
+/**
+ * @brief Gets the memory used by the world, per chunk and aggregated per subsystem
+ * @return Memory report
+ */
+WorldMemoryReport World::GetMemoryReport() const
+{
+	WorldMemoryReport ret;
+	ret.mappedRegionFileBytes = 0;
+
+	const std::list<Chunk*>& cachedChunks = m_chunkCache.GetChunks();
+	ret.chunks.reserve(m_chunks.size() + cachedChunks.size());
+
+	for (size_t i = 0; i < m_chunks.size(); ++i)
+	{
+		ChunkMemoryReport chunkReport;
+		chunkReport.chunkIndex = m_chunks[i]->GetChunkIndices();
+		chunkReport.isCached = false;
+		chunkReport.usage = m_chunks[i]->GetMemoryUsage();
+		ret.loadedChunks += chunkReport.usage;
+		ret.chunks.push_back(chunkReport);
+	}
+
+	for (std::list<Chunk*>::const_iterator it = cachedChunks.begin(); it != cachedChunks.end(); ++it)
+	{
+		ChunkMemoryReport chunkReport;
+		chunkReport.chunkIndex = (*it)->GetChunkIndices();
+		chunkReport.isCached = true;
+		chunkReport.usage = (*it)->GetMemoryUsage();
+		ret.cachedChunks += chunkReport.usage;
+		ret.chunks.push_back(chunkReport);
+	}
+
+	ret.pooledChunks = m_chunkPool.GetMemoryUsage();
+
+	// List nodes of the cache are two pointers plus the chunk pointer, and its map nodes are a key, an iterator and a next pointer
+	ret.world.bookkeepingBytes = sizeof(World)
+		+ m_chunks.capacity() * sizeof(Chunk*)
+		+ m_chunkContainer->GetMemoryUsage()
+		+ m_sharedSections.GetMemoryUsage() - sizeof(SharedSectionTable)
+		+ cachedChunks.size() * (3 * sizeof(void*) + sizeof(uint64_t) + 2 * sizeof(void*))
+		+ m_regionFiles.size() * (sizeof(std::pair<const uint64_t, RegionFile*>) + sizeof(void*) + sizeof(RegionFile))
+		+ m_regionFiles.bucket_count() * sizeof(void*);
+
+	for (std::unordered_map<uint64_t, RegionFile*>::const_iterator it = m_regionFiles.begin(); it != m_regionFiles.end(); ++it)
+	{
+		if (it->second != nullptr)
+		{
+			ret.mappedRegionFileBytes += it->second->GetMappedSize();
+		}
+	}
+
+	ret.total += ret.loadedChunks;
+	ret.total += ret.cachedChunks;
+	ret.total += ret.pooledChunks;
+	ret.total += ret.world;
+	return ret;
+}
+
+/**
+ * @brief Writes the memory report to a text file
+ * @param[in] filePath Path to the file
+ * @return True if the file was written
+ */
+bool World::DumpMemoryReport(const std::string& filePath) const
+{
+	std::ofstream file(filePath.c_str());
+	if (!file.is_open())
+	{
+		std::cerr << "[World] Failed to open " << filePath << " for writing" << std::endl;
+		return false;
+	}
+
+	WorldMemoryReport report = GetMemoryReport();
+
+	const char* categoryNames[] = { "loaded", "cached", "pooled", "world", "total" };
+	const MemoryUsage* categories[] = { &report.loadedChunks, &report.cachedChunks, &report.pooledChunks, &report.world, &report.total };
+
+	file << "category,block_storage,cpu_mesh,gpu_buffers,bookkeeping,total" << std::endl;
+	for (size_t i = 0; i < sizeof(categories) / sizeof(categories[0]); ++i)
+	{
+		file << categoryNames[i] << ","
+			<< categories[i]->blockStorageBytes << ","
+			<< categories[i]->cpuMeshBytes << ","
+			<< categories[i]->gpuBufferBytes << ","
+			<< categories[i]->bookkeepingBytes << ","
+			<< categories[i]->GetTotal() << std::endl;
+	}
+	file << "mapped_region_files," << report.mappedRegionFileBytes << std::endl;
+	file << std::endl;
+
+	file << "chunk_x,chunk_y,chunk_z,state,block_storage,cpu_mesh,gpu_buffers,bookkeeping,total" << std::endl;
+	for (size_t i = 0; i < report.chunks.size(); ++i)
+	{
+		const ChunkMemoryReport& chunkReport = report.chunks[i];
+		file << chunkReport.chunkIndex.x << ","
+			<< chunkReport.chunkIndex.y << ","
+			<< chunkReport.chunkIndex.z << ","
+			<< (chunkReport.isCached ? "cached" : "loaded") << ","
+			<< chunkReport.usage.blockStorageBytes << ","
+			<< chunkReport.usage.cpuMeshBytes << ","
+			<< chunkReport.usage.gpuBufferBytes << ","
+			<< chunkReport.usage.bookkeepingBytes << ","
+			<< chunkReport.usage.GetTotal() << std::endl;
+	}
+
+	return file.good();
+}
+
+/**
+ * @brief Gets the pool of unloaded chunks
+ * @return Chunk pool
+ */
+const ChunkPool& World::GetChunkPool() const
+{
+	return m_chunkPool;
+}
+
+/**
+ * @brief Sets the maximum number of bytes that chunks outside the loaded area can use
+ * @param[in] budget Budget in bytes
+ */
+void World::SetChunkCacheBudget(const size_t& budget)
+{
+	m_chunkCache.SetBudget(budget);
+	EvictCachedChunks();
+}
+
+/**
+ * @brief Gets the cache of chunks outside the loaded area
+ * @return Chunk cache
+ */
+const ChunkCache& World::GetChunkCache() const
+{
+	return m_chunkCache;
+}
+
+/**
+ * @brief Gets the background deleter of chunks that do not fit in the chunk pool
+ * @return Chunk reclaimer
+ */
+const ChunkReclaimer& World::GetChunkReclaimer() const
+{
+	return m_chunkReclaimer;
+}
+
+/**
+ * @brief Gets the job system generating and meshing new chunks
+ * @return Job system
+ */
+const JobSystem& World::GetJobSystem() const
+{
+	return *m_jobSystem;
+}
+
+/**
+ * @brief Gets the backend reading and writing saved chunk data
+ * @return Chunk I/O backend
+ */
+const BaseChunkIO& World::GetChunkIO() const
+{
+	return *m_chunkIO;
+}
+
+/**
+ * @brief Gets the GL objects waiting to be deleted
+ * @return GL deletion queue
+ */
+const GLDeletionQueue& World::GetGLDeletionQueue() const
+{
+	return m_glDeletionQueue;
+}
+
+/**
+ * @brief Deletes the GL objects of chunks that were deleted since the last call.
+ * Should be called once per frame on the render thread.
+ */
+void World::FlushDeferredDeletions()
+{
+	m_glDeletionQueue.Flush();
+}
+
+/**
+ * @brief Gets the table of sections shared between chunks
+ * @return Shared section table
+ */
+const SharedSectionTable& World::GetSharedSections() const
+{
+	return m_sharedSections;
+}
+
+/**
+ * @brief Gets the number of loaded chunks
+ * @return Number of loaded chunks
+ */
+size_t World::GetLoadedChunkCount() const
+{
+	return m_chunks.size();
+}
+
+/**
+ * @brief Gets the number of loaded and cached chunks in each stage of their lifecycle
+ * @return Number of chunks, indexed by ChunkStateEnum
+ */
+ChunkStateCounts World::GetChunkStateCounts() const
+{
+	ChunkStateCounts ret;
+	ret.fill(0);
+
+	for (size_t i = 0; i < m_chunks.size(); ++i)
+	{
+		++ret[static_cast<size_t>(m_chunks[i]->GetState())];
+	}
+
+	const std::list<Chunk*>& cachedChunks = m_chunkCache.GetChunks();
+	for (std::list<Chunk*>::const_iterator it = cachedChunks.begin(); it != cachedChunks.end(); ++it)
+	{
+		++ret[static_cast<size_t>((*it)->GetState())];
+	}
+
+	// Chunks whose saved data is being read do not exist yet
+	ret[static_cast<size_t>(ChunkStateEnum::REQUESTED)] += m_pendingLoads.size();
+
+	for (std::unordered_map<uint64_t, Chunk*>::const_iterator it = m_generatingChunks.begin(); it != m_generatingChunks.end(); ++it)
+	{
+		++ret[static_cast<size_t>(it->second->GetState())];
+	}
+
+	return ret;
+}
+
+/**
+ * @brief Gets the distance along the ray at which it leaves the horizontal slice of the chunk between the specified heights
+ * @param[in] ray Ray
+ * @param[in] chunk Chunk containing the slice
+ * @param[in] minY Bottom of the slice, in blocks
+ * @param[in] maxY Top of the slice (exclusive), in blocks
+ * @return Distance along the ray at which it exits the slice
+ */
+float World::GetChunkSliceExitDistance(const Ray& ray, Chunk* chunk, const int& minY, const int& maxY)
+{
+	glm::vec3 sliceMin = glm::vec3(CoordinateUtils::LocalToBlockPosition(chunk->GetChunkIndices(), glm::ivec3(0, minY, 0))) * Constants::BLOCK_SIZE;
+	glm::vec3 sliceMax = sliceMin + glm::vec3(Constants::CHUNK_WIDTH, maxY - minY, Constants::CHUNK_DEPTH) * Constants::BLOCK_SIZE;
+
+	float exitDistance = std::numeric_limits<float>::max();
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		if (ray.direction[axis] > 0.0f)
+		{
+			exitDistance = glm::min(exitDistance, (sliceMax[axis] - ray.origin[axis]) / ray.direction[axis]);
+		}
+		else if (ray.direction[axis] < 0.0f)
+		{
+			exitDistance = glm::min(exitDistance, (sliceMin[axis] - ray.origin[axis]) / ray.direction[axis]);
+		}
+	}
+
+	return exitDistance;
+}
+
+/**
+ * @brief Gets the chunk at the provided location indices, starting the search from a nearby chunk.
+ * If the target chunk is adjacent to the starting chunk, the neighbor link is used instead of a lookup.
+ * @param[in] fromChunk Chunk to start from. Can be nullptr.
+ * @param[in] chunkIndexX Chunk x-index
+ * @param[in] chunkIndexY Chunk y-index
+ * @param[in] chunkIndexZ Chunk z-index
+ * @return Chunk at the provided location. Returns nullptr if the chunk has not been generated yet.
+ */
+Chunk* World::GetChunkNear(Chunk* fromChunk, const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ)
+{
+	if (fromChunk != nullptr)
+	{
+		glm::ivec3 delta = glm::ivec3(chunkIndexX, chunkIndexY, chunkIndexZ) - fromChunk->GetChunkIndices();
+		if (delta == glm::ivec3(0))
+		{
+			return fromChunk;
+		}
+
+		for (int i = 0; i < static_cast<int>(ChunkNeighborEnum::COUNT); ++i)
+		{
+			if (delta == NEIGHBOR_OFFSETS[i])
+			{
+				return fromChunk->GetNeighbor(static_cast<ChunkNeighborEnum>(i));
+			}
+		}
+	}
+
+	return GetChunkAt(chunkIndexX, chunkIndexY, chunkIndexZ);
+}
+
+/**
+ * @brief Adds the chunk to the chunk list and links it with its loaded neighbors
+ * @param[in] chunk Chunk to add
+ * @return True if the chunk was added, false if the chunk container has no room for it
+ */
+bool World::AddChunk(Chunk* chunk)
+{
+	glm::ivec3 chunkIndex = chunk->GetChunkIndices();
+
+	if (!m_chunkContainer->Add(chunk))
+	{
+		return false;
+	}
+	m_chunks.push_back(chunk);
+	chunk->SetState(ChunkStateEnum::VISIBLE);
+
+	for (int i = 0; i < static_cast<int>(ChunkNeighborEnum::COUNT); ++i)
+	{
+		ChunkNeighborEnum direction = static_cast<ChunkNeighborEnum>(i);
+		glm::ivec3 neighborIndex = chunkIndex + NEIGHBOR_OFFSETS[i];
+		Chunk* neighbor = GetChunkAt(neighborIndex.x, neighborIndex.y, neighborIndex.z);
+		chunk->SetNeighbor(direction, neighbor);
+		if (neighbor != nullptr)
+		{
+			neighbor->SetNeighbor(GetOppositeNeighbor(direction), chunk);
+		}
+	}
+
+	return true;
+}
+
+/**
+ * @brief Unlinks the chunk from its neighbors and removes it from the chunk index.
+ * Does not remove the chunk from the chunk list.
+ * @param[in] chunk Chunk to remove
+ */
+void World::RemoveChunkFromIndex(Chunk* chunk)
+{
+	m_chunkContainer->Remove(chunk);
+
+	for (int i = 0; i < static_cast<int>(ChunkNeighborEnum::COUNT); ++i)
+	{
+		ChunkNeighborEnum direction = static_cast<ChunkNeighborEnum>(i);
+		Chunk* neighbor = chunk->GetNeighbor(direction);
+		if (neighbor != nullptr)
+		{
+			neighbor->SetNeighbor(GetOppositeNeighbor(direction), nullptr);
+		}
+		chunk->SetNeighbor(direction, nullptr);
+	}
+}
+
+/**
+ * @brief Gets the region file containing the chunk at the provided location indices, opening it if needed
+ * @param[in] chunkIndexX Chunk x-index
+ * @param[in] chunkIndexY Chunk y-index
+ * @param[in] chunkIndexZ Chunk z-index
+ * @param[out] localX Chunk x-index within the region
+ * @param[out] localY Chunk y-index within the region
+ * @param[out] localZ Chunk z-index within the region
+ * @return Region file. Returns nullptr if saving is disabled or the region file could not be opened.
+ */
+RegionFile* World::GetRegionFile(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ, int& localX, int& localY, int& localZ)
+{
+	if (m_saveDirectory.empty())
+	{
+		return nullptr;
+	}
+
+	// Round towards negative infinity so that negative chunk indices map to the correct region
+	int regionX = (chunkIndexX >= 0 ? chunkIndexX : chunkIndexX - Constants::REGION_SIZE + 1) / Constants::REGION_SIZE;
+	int regionY = (chunkIndexY >= 0 ? chunkIndexY : chunkIndexY - Constants::REGION_SIZE + 1) / Constants::REGION_SIZE;
+	int regionZ = (chunkIndexZ >= 0 ? chunkIndexZ : chunkIndexZ - Constants::REGION_SIZE + 1) / Constants::REGION_SIZE;
+	localX = chunkIndexX - regionX * Constants::REGION_SIZE;
+	localY = chunkIndexY - regionY * Constants::REGION_SIZE;
+	localZ = chunkIndexZ - regionZ * Constants::REGION_SIZE;
+
+	uint64_t key = CoordinateUtils::PackChunkIndex(regionX, regionY, regionZ);
+	std::unordered_map<uint64_t, RegionFile*>::iterator it = m_regionFiles.find(key);
+	if (it != m_regionFiles.end())
+	{
+		return it->second;
+	}
+
+	std::stringstream filePath;
+	filePath << m_saveDirectory << "/r." << regionX << "." << regionY << "." << regionZ << ".region";
+
+	RegionFile* regionFile = new RegionFile();
+	if (!regionFile->Open(filePath.str()))
+	{
+		delete regionFile;
+		regionFile = nullptr;
+	}
+
+	m_regionFiles[key] = regionFile;
+	return regionFile;
+}
+
+/**
+ * @brief Creates the chunk at the provided location indices from its serialized block data
+ * @param[in] chunkIndexX Chunk x-index
+ * @param[in] chunkIndexY Chunk y-index
+ * @param[in] chunkIndexZ Chunk z-index
+ * @param[in] blockData Serialized block data
+ * @param[in] blockDataSize Size of the block data in bytes
+ * @return Loaded chunk. Returns nullptr if the block data is corrupted.
+ */
+Chunk* World::DeserializeChunkAt(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ, const uint8_t* blockData, const size_t& blockDataSize)
+{
+	Chunk* chunk = m_chunkPool.Acquire(chunkIndexX, chunkIndexY, chunkIndexZ);
+	chunk->SetState(ChunkStateEnum::GENERATING);
+	if (!chunk->Deserialize(blockData, blockDataSize))
+	{
+		std::cerr << "[World] Saved data for chunk " << chunkIndexX << ", " << chunkIndexY << ", " << chunkIndexZ << " is corrupted" << std::endl;
+		ReleaseChunk(chunk);
+		return nullptr;
+	}
+
+	chunk->CompactSections();
+	chunk->ShareSections(m_sharedSections);
+	chunk->SetState(ChunkStateEnum::GENERATED);
+
+	chunk->SetState(ChunkStateEnum::MESHING);
+	chunk->GenerateMesh();
+	chunk->SetState(ChunkStateEnum::UPLOADED);
+	chunk->MarkSaved();
+
+	if (!AddChunk(chunk))
+	{
+		std::cerr << "[World] No room in the chunk container for chunk " << chunkIndexX << ", " << chunkIndexY << ", " << chunkIndexZ << std::endl;
+		ReleaseChunk(chunk);
+		chunk = nullptr;
+	}
+
+	return chunk;
+}
+
+/**
+ * @brief Gets the saved data of the chunk at the provided location indices without waiting for the chunk I/O backend
+ * @param[in] chunkIndexX Chunk x-index
+ * @param[in] chunkIndexY Chunk y-index
+ * @param[in] chunkIndexZ Chunk z-index
+ * @param[out] data Saved data, starting with its payload type
+ * @param[out] size Size of the saved data in bytes
+ * @return True if the chunk was saved
+ */
+bool World::GetSavedChunkData(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ, const uint8_t*& data, size_t& size)
+{
+	data = nullptr;
+	size = 0;
+
+	// The region file may not hold saves that are still being written
+	std::unordered_map<uint64_t, PendingChunkWrite>::const_iterator writeIt = m_pendingWrites.find(CoordinateUtils::PackChunkIndex(chunkIndexX, chunkIndexY, chunkIndexZ));
+	if (writeIt != m_pendingWrites.end())
+	{
+		data = writeIt->second.data->data();
+		size = writeIt->second.data->size();
+		return true;
+	}
+
+	int localX = 0;
+	int localY = 0;
+	int localZ = 0;
+	RegionFile* regionFile = GetRegionFile(chunkIndexX, chunkIndexY, chunkIndexZ, localX, localY, localZ);
+
+	// The data is read straight from the mapped file
+	return (regionFile != nullptr) && regionFile->ReadChunk(localX, localY, localZ, data, size);
+}
+
+/**
+ * @brief Starts reading the saved data of the chunk at the provided location indices.
+ * The chunk is added to the world once the data has been read.
+ * @param[in] chunkIndexX Chunk x-index
+ * @param[in] chunkIndexY Chunk y-index
+ * @param[in] chunkIndexZ Chunk z-index
+ * @return True if the chunk is being loaded from its saved data, false if it was never saved and has to be generated
+ */
+bool World::RequestChunkLoad(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ)
+{
+	uint64_t key = CoordinateUtils::PackChunkIndex(chunkIndexX, chunkIndexY, chunkIndexZ);
+	if (m_pendingLoads.find(key) != m_pendingLoads.end())
+	{
+		return true;
+	}
+
+	// Saves that are still being written are already in memory
+	std::unordered_map<uint64_t, PendingChunkWrite>::const_iterator writeIt = m_pendingWrites.find(key);
+	if (writeIt != m_pendingWrites.end())
+	{
+		std::shared_ptr<std::vector<uint8_t>> data = writeIt->second.data;
+		LoadChunkFromSavedData(chunkIndexX, chunkIndexY, chunkIndexZ, data->data(), data->size());
+		return true;
+	}
+
+	int localX = 0;
+	int localY = 0;
+	int localZ = 0;
+	RegionFile* regionFile = GetRegionFile(chunkIndexX, chunkIndexY, chunkIndexZ, localX, localY, localZ);
+
+	uint64_t offset = 0;
+	size_t size = 0;
+	if ((regionFile == nullptr) || !regionFile->LocateChunk(localX, localY, localZ, offset, size))
+	{
+		return false;
+	}
+
+	ChunkIORequest* request = new ChunkIORequest();
+	request->operation = ChunkIOOperationEnum::READ;
+	request->regionFile = regionFile;
+	request->offset = offset;
+	request->data = std::make_shared<std::vector<uint8_t>>(size);
+	request->succeeded = false;
+	request->callback = [this, chunkIndexX, chunkIndexY, chunkIndexZ](ChunkIORequest& completedRequest)
+	{
+		FinishChunkLoad(chunkIndexX, chunkIndexY, chunkIndexZ, completedRequest);
+	};
+
+	m_pendingLoads.insert(key);
+	m_chunkIO->Enqueue(request);
+	return true;
+}
+
+/**
+ * @brief Creates the chunk from its saved data, or starts generating it if the data is only a journal of edits
+ * @param[in] chunkIndexX Chunk x-index
+ * @param[in] chunkIndexY Chunk y-index
+ * @param[in] chunkIndexZ Chunk z-index
+ * @param[in] data Saved data, starting with its payload type
+ * @param[in] size Size of the saved data in bytes
+ */
+void World::LoadChunkFromSavedData(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ, const uint8_t* data, const size_t& size)
+{
+	ChunkPayloadTypeEnum payloadType = static_cast<ChunkPayloadTypeEnum>(data[0]);
+	if (payloadType == ChunkPayloadTypeEnum::EDIT_JOURNAL)
+	{
+		RequestChunkGeneration(chunkIndexX, chunkIndexY, chunkIndexZ, data + 1, size - 1);
+		return;
+	}
+
+	if ((payloadType == ChunkPayloadTypeEnum::BLOCK_DATA) && (DeserializeChunkAt(chunkIndexX, chunkIndexY, chunkIndexZ, data + 1, size - 1) != nullptr))
+	{
+		return;
+	}
+
+	// Chunks with unusable saved data are generated again
+	RequestChunkGeneration(chunkIndexX, chunkIndexY, chunkIndexZ, nullptr, 0);
+}
+
+/**
+ * @brief Reads the saved data of the chunks whose reads failed during the previous call to PollChunkIO() again
+ */
+void World::RetryFailedLoads()
+{
+	std::vector<glm::ivec3> failedLoads;
+	failedLoads.swap(m_failedLoads);
+	for (size_t i = 0; i < failedLoads.size(); ++i)
+	{
+		int chunkIndexX = failedLoads[i].x;
+		int chunkIndexY = failedLoads[i].y;
+		int chunkIndexZ = failedLoads[i].z;
+		uint64_t key = CoordinateUtils::PackChunkIndex(chunkIndexX, chunkIndexY, chunkIndexZ);
+		m_pendingLoads.erase(key);
+		if (!IsInsideLoadedArea(chunkIndexX, chunkIndexY, chunkIndexZ) || (GetChunkAt(chunkIndexX, chunkIndexY, chunkIndexZ) != nullptr))
+		{
+			m_numFailedReads.erase(key);
+			continue;
+		}
+
+		// The chunk may have been saved again in the meantime, in which case its data is already in memory
+		if (!RequestChunkLoad(chunkIndexX, chunkIndexY, chunkIndexZ))
+		{
+			m_numFailedReads.erase(key);
+			RequestChunkGeneration(chunkIndexX, chunkIndexY, chunkIndexZ, nullptr, 0);
+		}
+		else if (m_pendingLoads.find(key) == m_pendingLoads.end())
+		{
+			m_numFailedReads.erase(key);
+		}
+	}
+}
+
+/**
+ * @brief Loads the chunk whose saved data finished reading, unless it left the loaded area in the meantime.
+ * Failed reads are tried again on the next call to PollChunkIO().
+ * @param[in] chunkIndexX Chunk x-index
+ * @param[in] chunkIndexY Chunk y-index
+ * @param[in] chunkIndexZ Chunk z-index
+ * @param[in] request Completed read request
+ */
+void World::FinishChunkLoad(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ, const ChunkIORequest& request)
+{
+	uint64_t key = CoordinateUtils::PackChunkIndex(chunkIndexX, chunkIndexY, chunkIndexZ);
+	m_pendingLoads.erase(key);
+	if (!IsInsideLoadedArea(chunkIndexX, chunkIndexY, chunkIndexZ) || (GetChunkAt(chunkIndexX, chunkIndexY, chunkIndexZ) != nullptr))
+	{
+		m_numFailedReads.erase(key);
+		return;
+	}
+
+	if (!request.succeeded)
+	{
+		std::cerr << "[World] Failed to read saved data for chunk " << chunkIndexX << ", " << chunkIndexY << ", " << chunkIndexZ << std::endl;
+
+		// The chunk stays pending, so loading its area again does not request it a second time
+		uint32_t& numFailedReads = m_numFailedReads[key];
+		++numFailedReads;
+		if (numFailedReads < Constants::MAX_CHUNK_READ_ATTEMPTS)
+		{
+			m_pendingLoads.insert(key);
+			m_failedLoads.push_back(glm::ivec3(chunkIndexX, chunkIndexY, chunkIndexZ));
+			return;
+		}
+
+		// Generating the chunk instead would overwrite its saved edits on the next save, so it is requested again the next time its area is loaded
+		m_numFailedReads.erase(key);
+		return;
+	}
+
+	m_numFailedReads.erase(key);
+	LoadChunkFromSavedData(chunkIndexX, chunkIndexY, chunkIndexZ, request.data->data(), request.data->size());
+}
+
+/**
+ * @brief Starts writing the data of the chunk save to the pages reserved for it
+ * @param[in] pendingWrite Chunk save to write
+ */
+void World::WriteChunkData(PendingChunkWrite& pendingWrite)
+{
+	++pendingWrite.numInFlight;
+
+	int chunkIndexX = pendingWrite.chunkIndex.x;
+	int chunkIndexY = pendingWrite.chunkIndex.y;
+	int chunkIndexZ = pendingWrite.chunkIndex.z;
+
+	ChunkIORequest* request = new ChunkIORequest();
+	request->operation = ChunkIOOperationEnum::WRITE;
+	request->regionFile = pendingWrite.regionFile;
+	request->offset = pendingWrite.offset;
+	request->data = pendingWrite.data;
+	request->succeeded = false;
+	request->callback = [this, chunkIndexX, chunkIndexY, chunkIndexZ](ChunkIORequest& completedRequest)
+	{
+		FinishChunkSave(chunkIndexX, chunkIndexY, chunkIndexZ, completedRequest);
+	};
+	m_chunkIO->Enqueue(request);
+}
+
+/**
+ * @brief Forgets the data of a chunk save once it has been written. Failed writes are tried again,
+ * and once they keep failing the chunk is marked as unsaved if it is still loaded or cached.
+ * @param[in] chunkIndexX Chunk x-index
+ * @param[in] chunkIndexY Chunk y-index
+ * @param[in] chunkIndexZ Chunk z-index
+ * @param[in] request Completed write request
+ */
+void World::FinishChunkSave(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ, const ChunkIORequest& request)
+{
+	std::unordered_map<uint64_t, PendingChunkWrite>::iterator it = m_pendingWrites.find(CoordinateUtils::PackChunkIndex(chunkIndexX, chunkIndexY, chunkIndexZ));
+	if (it == m_pendingWrites.end())
+	{
+		return;
+	}
+
+	PendingChunkWrite& pendingWrite = it->second;
+	--pendingWrite.numInFlight;
+
+	// A failed write of an older save does not matter once a newer save of the chunk was written over it
+	if (request.succeeded && (request.data == pendingWrite.data))
+	{
+		pendingWrite.numFailedWrites = 0;
+	}
+	else if (!request.succeeded && (request.data == pendingWrite.data))
+	{
+		std::cerr << "[World] Failed to save chunk " << chunkIndexX << ", " << chunkIndexY << ", " << chunkIndexZ << std::endl;
+
+		// The offset table already points at the reserved pages, so the data is written to them again
+		++pendingWrite.numFailedWrites;
+		if (pendingWrite.numFailedWrites < Constants::MAX_CHUNK_WRITE_ATTEMPTS)
+		{
+			WriteChunkData(pendingWrite);
+			return;
+		}
+
+		// A chunk that is still around is saved again with freshly reserved pages when it is next saved
+		Chunk* chunk = GetChunkAt(chunkIndexX, chunkIndexY, chunkIndexZ);
+		if (chunk == nullptr)
+		{
+			chunk = m_chunkCache.Find(chunkIndexX, chunkIndexY, chunkIndexZ);
+		}
+
+		if (chunk == nullptr)
+		{
+			// Otherwise the data is kept, so loads still read it from memory and SaveChunks() writes it again
+			return;
+		}
+
+		chunk->MarkUnsaved();
+		pendingWrite.numFailedWrites = 0;
+	}
+
+	if ((pendingWrite.numInFlight == 0) && (pendingWrite.numFailedWrites == 0))
+	{
+		m_pendingWrites.erase(it);
+	}
+}
+
+/**
+ * @brief Checks whether the chunk is within the area passed to the last call to LoadChunksWithinArea()
+ * @param[in] chunkIndexX Chunk x-index
+ * @param[in] chunkIndexY Chunk y-index
+ * @param[in] chunkIndexZ Chunk z-index
+ * @return True if the chunk is within the loaded area
+ */
+bool World::IsInsideLoadedArea(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ) const
+{
+	return (glm::abs(chunkIndexX - m_loadCenter.x) <= m_loadRadius) && (glm::abs(chunkIndexY - m_loadCenter.y) <= m_loadVerticalRadius)
+		&& (glm::abs(chunkIndexZ - m_loadCenter.z) <= m_loadRadius);
+}
+
+/**
+ * @brief Applies a saved edit journal on top of the generated terrain of the chunk
+ * @param[in] chunk Chunk with freshly generated terrain
+ * @param[in] savedEdits Serialized edit journal
+ * @param[in] savedEditsSize Size of the edit journal in bytes
+ */
+void World::ReplaySavedEdits(Chunk* chunk, const uint8_t* savedEdits, const size_t& savedEditsSize) const
+{
+	std::vector<ChunkEditJournal::Entry> entries;
+	if (!ChunkEditJournal::Deserialize(savedEdits, savedEditsSize, entries))
+	{
+		std::cerr << "[World] Saved edits for chunk " << chunk->GetChunkIndexX() << ", " << chunk->GetChunkIndexY() << ", " << chunk->GetChunkIndexZ() << " are corrupted" << std::endl;
+		return;
+	}
+
+	for (size_t i = 0; i < entries.size(); ++i)
+	{
+		int x = 0;
+		int y = 0;
+		int z = 0;
+		ChunkEditJournal::UnpackPosition(entries[i].packedPosition, x, y, z);
+		chunk->SetBlockAt(x, y, z, entries[i].type);
+	}
+}
+
+/**
+ * @brief Moves the chunk at the provided location indices from the chunk cache back into the world
+ * @param[in] chunkIndexX Chunk x-index
+ * @param[in] chunkIndexY Chunk y-index
+ * @param[in] chunkIndexZ Chunk z-index
+ * @return Restored chunk. Returns nullptr if the chunk is not in the cache.
+ */
+Chunk* World::RestoreCachedChunkAt(const int& chunkIndexX, const int& chunkIndexY, const int& chunkIndexZ)
+{
+	Chunk* chunk = m_chunkCache.Take(chunkIndexX, chunkIndexY, chunkIndexZ);
+	if (chunk == nullptr)
+	{
+		return nullptr;
+	}
+
+	if (chunk->IsBlockDataCompressed() || !chunk->HasMeshes())
+	{
+		std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+		if (chunk->IsBlockDataCompressed())
+		{
+			chunk->DecompressBlockData();
+			chunk->ShareSections(m_sharedSections);
+		}
+		if (!chunk->HasMeshes())
+		{
+			chunk->SetState(ChunkStateEnum::MESHING);
+			chunk->GenerateMesh();
+		}
+		std::chrono::duration<float, std::milli> rehydrationTime = std::chrono::steady_clock::now() - startTime;
+		m_chunkCache.RecordRehydration(rehydrationTime.count());
+	}
+
+	chunk->SetState(ChunkStateEnum::UPLOADED);
+	if (!AddChunk(chunk))
+	{
+		std::cerr << "[World] No room in the chunk container for chunk " << chunkIndexX << ", " << chunkIndexY << ", " << chunkIndexZ << std::endl;
+		SaveChunk(chunk);
+		ReleaseChunk(chunk);
+		chunk = nullptr;
+	}
+
+	return chunk;
+}
+
+/**
+ * @brief Evicts chunks from the chunk cache until it fits in its budget, saving them if needed
+ */
+void World::EvictCachedChunks()
+{
+	std::vector<Chunk*> evictedChunks;
+	m_chunkCache.EnforceBudget(evictedChunks);
+	for (size_t i = 0; i < evictedChunks.size(); ++i)
+	{
+		SaveChunk(evictedChunks[i]);
+		ReleaseChunk(evictedChunks[i]);
+	}
+
+	m_chunkIO->Submit();
+}
+
+/**
+ * @brief Returns the chunk to the chunk pool. If the pool is full, the GL objects of the chunk are queued
+ * for deletion and the rest of the chunk is deleted on the reclaimer thread.
+ * @param[in] chunk Chunk that was removed from the world and the chunk cache
+ */
+void World::ReleaseChunk(Chunk* chunk)
+{
+	if (!m_chunkPool.Release(chunk))
+	{
+		chunk->DeferMeshBufferDeletion(m_glDeletionQueue);
+		m_chunkReclaimer.Reclaim(chunk);
+	}
 }